@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    BatchBenchmark.cpp
+    Created: 26 Oct 2026 2:41:55pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/BatchEngine.h"
+
+namespace
+{
+    // Renders the streams through plugin instances, two per instance as a bounce would, and returns the seconds it took
+    double renderPlugin(juce::AudioBuffer<float>& streams, double sampleRate, int blockSize)
+    {
+        juce::OwnedArray<SoftClippingPreampAudioProcessor> processors;
+
+        for (int k = 0; k < streams.getNumChannels(); k += 2)
+        {
+            auto* processor = processors.add(new SoftClippingPreampAudioProcessor());
+            processor->setNonRealtime(true);
+            processor->setParallelOfflineChannels(false);
+            processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor->prepareToPlay(sampleRate, blockSize);
+        }
+
+        // The cabinet's mic blend gets baked in the background, both renders should start with it
+        juce::Thread::sleep(500);
+
+        juce::MidiBuffer midi;
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int position = 0; position < streams.getNumSamples(); position += blockSize)
+        {
+            auto numSamples = juce::jmin(blockSize, streams.getNumSamples() - position);
+
+            for (int i = 0; i < processors.size(); ++i)
+            {
+                auto numChannels = juce::jmin(2, streams.getNumChannels() - 2 * i);
+                juce::AudioBuffer<float> block(streams.getArrayOfWritePointers() + 2 * i, numChannels, position, numSamples);
+                processors[i]->processBlock(block, midi);
+            }
+        }
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    }
+
+    // The same streams through one BatchEngine, designed by an instance with the same settings
+    double renderBatch(juce::AudioBuffer<float>& streams, double sampleRate, int blockSize)
+    {
+        // prepareToPlay loads the mic responses the cabinet gets baked from
+        SoftClippingPreampAudioProcessor designer;
+        designer.setNonRealtime(true);
+        designer.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        designer.prepareToPlay(sampleRate, blockSize);
+
+        auto settings = designer.getSettings();
+
+        BatchEngine engine;
+        engine.prepare(*designer.makeSnapshot(settings), streams.getNumChannels(), blockSize, Quality::High);
+        engine.loadCabinetResponse(designer.makeCabinetResponse(settings), designer.getCabinetSampleRate());
+
+        juce::dsp::AudioBlock<float> block(streams);
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int position = 0; position < streams.getNumSamples(); position += blockSize)
+        {
+            auto numSamples = juce::jmin(blockSize, streams.getNumSamples() - position);
+            engine.process(block.getSubBlock((size_t)position, (size_t)numSamples));
+        }
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    }
+
+    struct Difference
+    {
+        float maxError { 0 };
+        double decibels { -200 };
+    };
+
+    // The largest sample difference, and the energy of the difference relative to the reference's
+    Difference compare(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& other)
+    {
+        Difference result;
+        double signal = 0, difference = 0;
+
+        for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+        {
+            for (int i = 0; i < reference.getNumSamples(); ++i)
+            {
+                auto r = reference.getSample(channel, i), o = other.getSample(channel, i);
+                result.maxError = juce::jmax(result.maxError, std::abs(r - o));
+                signal += (double)r * r;
+                difference += ((double)r - o) * ((double)r - o);
+            }
+        }
+
+        result.decibels = juce::Decibels::gainToDecibels(std::sqrt(difference / juce::jmax(signal, 1.0e-30)), -200.0);
+        return result;
+    }
+}
+
+void runBatchBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 1024;
+    auto numStreams = args.containsOption("--streams") ? args.getValueForOption("--streams").getIntValue() : 16;
+    auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 5.0;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    // Every stream lags the one before it, so no instance falls back to running one chain
+    auto numSamples = (int)(seconds * sampleRate);
+    auto mono = makeTestSignal(sampleRate, numSamples);
+    auto lag = (int)(sampleRate * 0.01);
+
+    juce::AudioBuffer<float> input(numStreams, numSamples);
+
+    for (int k = 0; k < numStreams; ++k)
+    {
+        auto delay = juce::jmin(numSamples, k * lag);
+        input.clear(k, 0, delay);
+        input.copyFrom(k, delay, mono, 0, 0, numSamples - delay);
+    }
+
+    auto& best = SimdKernels::get();
+
+    std::cout << numStreams << " streams of " << seconds << " s, " << sampleRate << " Hz, " << blockSize
+              << " sample blocks, with the same settings" << std::endl;
+
+    // With the baseline kernels the lanes round exactly as the plugin's chain does
+    SimdKernels::setActive(SimdKernels::Isa::baseline);
+
+    juce::AudioBuffer<float> pluginBaseline(input), batchBaseline(input);
+    renderPlugin(pluginBaseline, sampleRate, blockSize);
+    renderBatch(batchBaseline, sampleRate, blockSize);
+
+    auto baselineDifference = compare(pluginBaseline, batchBaseline);
+
+    std::cout << "Baseline kernels   max difference " << juce::Decibels::gainToDecibels(baselineDifference.maxError, -200.f)
+              << " dB" << std::endl;
+
+    // The timed renders with the kernels the plugin picks, where the lanes use FMA and the fused pass doesn't
+    SimdKernels::setActive(best.isa);
+
+    juce::AudioBuffer<float> plugin(input), batch(input);
+    auto pluginSeconds = renderPlugin(plugin, sampleRate, blockSize);
+    auto batchSeconds = renderBatch(batch, sampleRate, blockSize);
+
+    auto difference = compare(plugin, batch);
+
+    std::cout << "Plugin instances   " << juce::String(pluginSeconds, 3) << " s   "
+              << juce::String(numStreams * seconds / pluginSeconds, 1) << " streams x realtime" << std::endl;
+    std::cout << "Batch engine       " << juce::String(batchSeconds, 3) << " s   "
+              << juce::String(numStreams * seconds / batchSeconds, 1) << " streams x realtime, "
+              << juce::String(pluginSeconds / batchSeconds, 2) << "x, " << best.name << " kernels "
+              << juce::String(difference.decibels, 1) << " dB apart" << std::endl;
+
+    if (baselineDifference.maxError > 1.0e-6f)
+        juce::ConsoleApplication::fail("The batch engine doesn't match the plugin with the baseline kernels");
+
+    if (difference.decibels > SimdKernels::maxDifferenceDecibels)
+        juce::ConsoleApplication::fail("The batch engine's kernels are too far from the plugin's");
+}
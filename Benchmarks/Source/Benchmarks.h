@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 19 Oct 2026 4:05:21pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <iostream>
+
+// Measures fn() a few times and returns the best time per call, in seconds
+template <typename Fn>
+double timeBestOf(int numRuns, Fn&& fn)
+{
+    auto best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < numRuns; ++run)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        fn();
+        auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        best = juce::jmin(best, elapsed);
+    }
+
+    return best;
+}
+
+// Plucks on top of a little noise, mono
+juce::AudioBuffer<float> makeTestSignal(double sampleRate, int numSamples);
+
+// Clipper curves and the diode model against the original std::function atan waveshaper
+void runClipperBenchmark(const juce::ArgumentList& args);
+
+// Many plugin instances sharing one simulated audio callback, until they miss its deadline
+void runStressBenchmark(const juce::ArgumentList& args);
+
+// The fused per sample stages against running them one after the other
+void runFusedBenchmark(const juce::ArgumentList& args);
+
+// An offline render with the two channels in parallel against one after the other
+void runOfflineBenchmark(const juce::ArgumentList& args);
+
+// The tone stack's sections against the same design as one third order filter, in float
+void runToneStackBenchmark(const juce::ArgumentList& args);
+
+// The kernels built for each instruction set the CPU has, against the baseline ones
+void runIsaBenchmark(const juce::ArgumentList& args);
+
+// Many streams with the same settings through one BatchEngine, against plugin instances
+void runBatchBenchmark(const juce::ArgumentList& args);
+
+// The light cabinet's fit of the response, and its cost against the convolution
+void runLightCabinetBenchmark(const juce::ArgumentList& args);
+
+// Aliasing, THD+N, response and latency of each processing mode against a double precision reference
+void runMeasureBenchmark(const juce::ArgumentList& args);
+
+// Toggling the bypass parameter, and the cost of a bypassed instance against a running one
+void runBypassBenchmark(const juce::ArgumentList& args);
+
+// The level meters against the signal they measure, and what measuring costs
+void runMeterBenchmark(const juce::ArgumentList& args);
+
+// Cache lines the filter sections take as FilterCascades against juce::dsp::IIR::Filters, and a block from cold caches
+void runLayoutBenchmark(const juce::ArgumentList& args);
+
+// The right chain taking over the left one's state when dual mono input stops, against one that always ran
+void runDualMonoBenchmark(const juce::ArgumentList& args);
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    BypassBenchmark.cpp
+    Created: 28 Oct 2026 4:26:51pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int numRuns = 5;
+
+    // The largest difference between neighbouring samples of the left channel, in [start, end)
+    float getLargestStep(const juce::AudioBuffer<float>& buffer, int start, int end)
+    {
+        float largest = 0;
+
+        for (int i = juce::jmax(1, start); i < juce::jmin(end, buffer.getNumSamples()); ++i)
+            largest = juce::jmax(largest, std::abs(buffer.getSample(0, i) - buffer.getSample(0, i - 1)));
+
+        return largest;
+    }
+
+    // Runs the buffer through in blocks, setting the bypass at the sample positions given
+    void render(SoftClippingPreampAudioProcessor& processor, juce::AudioBuffer<float>& buffer, int blockSize,
+                const std::vector<std::pair<int, bool>>& toggles = {})
+    {
+        juce::MidiBuffer midi;
+        size_t next = 0;
+
+        for (int position = 0; position < buffer.getNumSamples(); position += blockSize)
+        {
+            for (; next < toggles.size() && toggles[next].first <= position; ++next)
+                processor.getBypassParameter()->setValueNotifyingHost(toggles[next].second ? 1.f : 0.f);
+
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), position,
+                                           juce::jmin(blockSize, buffer.getNumSamples() - position));
+            processor.processBlock(block, midi);
+        }
+    }
+}
+
+void runBypassBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+    auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 8.0;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    // Stereo with the right channel lagging, so both chains run
+    auto numSamples = (int)(seconds * sampleRate);
+    auto mono = makeTestSignal(sampleRate, numSamples);
+    auto lag = (int)(sampleRate * 0.01);
+
+    juce::AudioBuffer<float> input(2, numSamples);
+    input.copyFrom(0, 0, mono, 0, 0, numSamples);
+    input.clear(1, 0, lag);
+    input.copyFrom(1, lag, mono, 0, 0, numSamples - lag);
+
+    auto prepare = [&] (SoftClippingPreampAudioProcessor& processor, bool bypassed)
+    {
+        processor.getBypassParameter()->setValueNotifyingHost(bypassed ? 1.f : 0.f);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    };
+
+    // On a quarter of the way in, off at half, on again at three quarters
+    SoftClippingPreampAudioProcessor toggled;
+    prepare(toggled, false);
+    juce::Thread::sleep(500);
+
+    auto quarter = numSamples / 4;
+    auto latency = toggled.getLatencySamples();
+
+    juce::AudioBuffer<float> output(input);
+    render(toggled, output, blockSize, { { quarter, true }, { 2 * quarter, false }, { 3 * quarter, true } });
+
+    // Once the fade is over the output is the input, delayed by the reported latency
+    auto settled = quarter + blockSize + (int)(sampleRate * 0.05);
+    float dryError = 0;
+
+    for (int channel = 0; channel < 2; ++channel)
+        for (int i = settled; i < 2 * quarter; ++i)
+            dryError = juce::jmax(dryError, std::abs(output.getSample(channel, i) - input.getSample(channel, i - latency)));
+
+    // No step around a toggle larger than the processed or the dry signal take on their own
+    auto fade = blockSize + (int)(sampleRate * 0.05);
+    auto processedStep = getLargestStep(output, 0, quarter);
+    auto dryStep = getLargestStep(input, 0, numSamples);
+    auto toggleStep = 0.f;
+
+    for (auto toggle : { quarter, 2 * quarter, 3 * quarter })
+        toggleStep = juce::jmax(toggleStep, getLargestStep(output, toggle - blockSize, toggle + fade));
+
+    auto allowedStep = 1.5f * juce::jmax(processedStep, dryStep);
+
+    // The cost of an instance running against one fully bypassed
+    SoftClippingPreampAudioProcessor active, bypassed;
+    prepare(active, false);
+    prepare(bypassed, true);
+    juce::Thread::sleep(500);
+
+    juce::AudioBuffer<float> work(2, numSamples);
+
+    auto activeSeconds = timeBestOf(numRuns, [&] {
+        work.makeCopyOf(input, true);
+        render(active, work, blockSize);
+    });
+
+    auto bypassedSeconds = timeBestOf(numRuns, [&] {
+        work.makeCopyOf(input, true);
+        render(bypassed, work, blockSize);
+    });
+
+    auto perSample = [&] (double s) { return juce::String(s * 1.0e9 / numSamples, 2) + " ns/sample"; };
+
+    std::cout << "Bypass at " << sampleRate << " Hz, " << blockSize << " sample blocks, " << latency << " samples of latency" << std::endl;
+    std::cout << "Bypassed output against the delayed input   max difference "
+              << juce::Decibels::gainToDecibels(dryError, -200.f) << " dB" << std::endl;
+    std::cout << "Largest step around a toggle                " << juce::String(toggleStep, 4) << ", allowed "
+              << juce::String(allowedStep, 4) << std::endl;
+    std::cout << "Active " << perSample(activeSeconds) << "   bypassed " << perSample(bypassedSeconds) << " ("
+              << juce::String(100.0 * bypassedSeconds / activeSeconds, 1) << "%)" << std::endl;
+
+    if (dryError > 0.f)
+        juce::ConsoleApplication::fail("The bypassed output isn't the input delayed by the latency");
+
+    if (toggleStep > allowedStep)
+        juce::ConsoleApplication::fail("Toggling the bypass clicks");
+}
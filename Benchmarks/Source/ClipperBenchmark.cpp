@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    ClipperBenchmark.cpp
+    Created: 19 Oct 2026 4:05:21pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/Clippers.h"
+
+namespace
+{
+    constexpr float drive = 60.f;
+    constexpr int numSeconds = 4;
+    constexpr int numRuns = 5;
+
+    template <typename ProcessFn>
+    double nanosecondsPerSample(const juce::AudioBuffer<float>& input, int blockSize, ProcessFn&& processBlock)
+    {
+        juce::AudioBuffer<float> work(1, input.getNumSamples());
+
+        auto seconds = timeBestOf(numRuns, [&] {
+            work.copyFrom(0, 0, input, 0, 0, input.getNumSamples());
+
+            for (int start = 0; start < work.getNumSamples(); start += blockSize)
+            {
+                auto numSamples = juce::jmin(blockSize, work.getNumSamples() - start);
+                juce::dsp::AudioBlock<float> block(work.getArrayOfWritePointers(), 1, (size_t)start, (size_t)numSamples);
+                processBlock(block);
+            }
+        });
+
+        return seconds * 1.0e9 / input.getNumSamples();
+    }
+}
+
+juce::AudioBuffer<float> makeTestSignal(double sampleRate, int numSamples)
+{
+    // a decaying pluck every 250 ms on top of some noise, roughly what a DI looks like
+    juce::AudioBuffer<float> signal(1, numSamples);
+    juce::Random random(1234);
+    auto* data = signal.getWritePointer(0);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto t = (double)(i % (int)(sampleRate / 4)) / sampleRate;
+        auto pluck = std::exp(-6.0 * t) * (std::sin(juce::MathConstants<double>::twoPi * 110.0 * t)
+                                           + 0.5 * std::sin(juce::MathConstants<double>::twoPi * 220.0 * t));
+        data[i] = (float)(0.6 * pluck) + 0.01f * (random.nextFloat() - 0.5f);
+    }
+
+    return signal;
+}
+
+void runClipperBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+
+    auto input = makeTestSignal(sampleRate, (int)sampleRate * numSeconds);
+    juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32)blockSize, 1 };
+
+    // The waveshaper the Clipping stage used to be
+    juce::dsp::WaveShaper<float, std::function<float(float)>> waveShaper;
+    waveShaper.functionToUse = [] (float x) {
+        return ( (2.f / juce::MathConstants<float>::pi) * std::atan(drive * x) ) + x;
+    };
+
+    auto baseline = nanosecondsPerSample(input, blockSize, [&] (juce::dsp::AudioBlock<float>& block) {
+        waveShaper.process(juce::dsp::ProcessContextReplacing<float>(block));
+    });
+
+    std::cout << "Clipper cost at " << sampleRate << " Hz, " << blockSize << " sample blocks, drive " << drive << std::endl;
+    std::cout << juce::String("std::function atan (previous)").paddedRight(' ', 36) << juce::String(baseline, 2) << " ns/sample" << std::endl;
+
+    auto report = [&] (const juce::String& name, auto&& configure) {
+        ClipperStage clipper;
+        clipper.prepare(spec);
+        clipper.setDrive(drive);
+        configure(clipper);
+
+        auto ns = nanosecondsPerSample(input, blockSize, [&] (juce::dsp::AudioBlock<float>& block) {
+            clipper.process(juce::dsp::ProcessContextReplacing<float>(block));
+        });
+
+        std::cout << name.paddedRight(' ', 36) << juce::String(ns, 2) << " ns/sample  ("
+                  << juce::String(ns / baseline, 2) << "x)" << std::endl;
+    };
+
+    for (auto type : { ClipperType::Atan, ClipperType::Tanh, ClipperType::Cubic, ClipperType::Hard, ClipperType::Asymmetric })
+    {
+        auto name = ClipperStage::getTypeNames()[(int)type];
+
+        report(name, [type] (ClipperStage& c) { c.setType(type); });
+        report(name + " approximated", [type] (ClipperStage& c) { c.setType(type); c.setUseApproximations(true); });
+        report(name + " ADAA", [type] (ClipperStage& c) { c.setType(type); c.setAntiderivativeAntialiasing(true); });
+    }
+
+    for (int iterations = 0; iterations <= 2; ++iterations)
+        report("Diode, " + juce::String(iterations) + " Newton steps",
+               [iterations] (ClipperStage& c) { c.setType(ClipperType::Diode); c.setDiodeNewtonIterations(iterations); });
+
+    // How far the table alone is from the converged solution
+    ClipperStage tableOnly, converged;
+
+    for (auto* c : { &tableOnly, &converged })
+    {
+        c->prepare(spec);
+        c->setDrive(drive);
+        c->setType(ClipperType::Diode);
+    }
+
+    converged.setDiodeNewtonIterations(4);
+
+    juce::AudioBuffer<float> a(input), b(input);
+    juce::dsp::AudioBlock<float> blockA(a), blockB(b);
+    tableOnly.process(juce::dsp::ProcessContextReplacing<float>(blockA));
+    converged.process(juce::dsp::ProcessContextReplacing<float>(blockB));
+
+    float maxError = 0;
+
+    for (int i = 0; i < input.getNumSamples(); ++i)
+        maxError = juce::jmax(maxError, std::abs(a.getSample(0, i) - b.getSample(0, i)));
+
+    std::cout << "Diode table error against 4 Newton steps: " << juce::Decibels::gainToDecibels(maxError, -200.f) << " dB" << std::endl;
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    DualMonoBenchmark.cpp
+    Created: 30 Oct 2026 3:41:09pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    // After the right output's 20 ms fade back, it has to match a right chain that never stopped this closely
+    constexpr double maxDifferenceDecibels = -60.0;
+
+    void render(juce::AudioBuffer<float>& buffer, double sampleRate, int blockSize)
+    {
+        SoftClippingPreampAudioProcessor processor;
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        // The cabinet's mic blend gets baked in the background, both renders should start with it
+        juce::Thread::sleep(500);
+
+        juce::MidiBuffer midi;
+
+        for (int position = 0; position < buffer.getNumSamples(); position += blockSize)
+        {
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, position,
+                                           juce::jmin(blockSize, buffer.getNumSamples() - position));
+            processor.processBlock(block, midi);
+        }
+    }
+
+    // The difference's energy relative to the reference's, over [start, end)
+    double getDifferenceDecibels(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference, int start, int end)
+    {
+        double difference = 0, energy = 0;
+
+        for (int i = start; i < end; ++i)
+        {
+            auto r = (double)reference.getSample(1, i);
+            difference += juce::square((double)output.getSample(1, i) - r);
+            energy += r * r;
+        }
+
+        return 10.0 * std::log10(juce::jmax(difference, 1.0e-30) / juce::jmax(energy, 1.0e-30));
+    }
+}
+
+void runDualMonoBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    // The same signal on both channels for a second, long enough for one chain to take over, then
+    // the right one quieter
+    auto numSamples = (int)(sampleRate * 2);
+    auto divergence = (int)(sampleRate * 1.0) + blockSize / 3;
+    auto signal = makeTestSignal(sampleRate, numSamples);
+
+    juce::AudioBuffer<float> input(2, numSamples);
+    input.copyFrom(0, 0, signal, 0, 0, numSamples);
+    input.copyFrom(1, 0, signal, 0, 0, numSamples);
+    input.applyGain(1, divergence, numSamples - divergence, 0.8f);
+
+    // The reference's right channel is a step off every few samples, so both its chains always run
+    juce::AudioBuffer<float> output(input), reference(input);
+
+    for (int i = 0; i < divergence; i += 16)
+        reference.setSample(1, i, std::nextafter(reference.getSample(1, i), 1.f));
+
+    render(output, sampleRate, blockSize);
+    render(reference, sampleRate, blockSize);
+
+    auto settled = divergence + (int)(sampleRate * 0.025);
+    auto transition = getDifferenceDecibels(output, reference, settled, settled + (int)(sampleRate * 0.1));
+    auto rest = getDifferenceDecibels(output, reference, settled + (int)(sampleRate * 0.1), numSamples);
+
+    std::cout << "Dual mono until " << juce::String(divergence / sampleRate, 3) << " s, " << sampleRate << " Hz, "
+              << blockSize << " sample blocks" << std::endl;
+    std::cout << "  Right output against a chain that never stopped, the 100 ms after the fade "
+              << juce::String(transition, 1) << " dB, the rest " << juce::String(rest, 1) << " dB" << std::endl;
+
+    if (transition > maxDifferenceDecibels || rest > maxDifferenceDecibels)
+        juce::ConsoleApplication::fail("The right chain doesn't carry on from the left one's state");
+}
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    FusedBenchmark.cpp
+    Created: 22 Oct 2026 2:03:12pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int numRuns = 5;
+
+    // The stages before the clipper as processChain runs them, with the plugin's designs and an
+    // input level ramp
+    struct PreClipper
+    {
+        juce::dsp::ProcessorChain<juce::dsp::Gain<float>, FilterCascade<1>> chain;
+        static constexpr float movedDecibels = 6.f;
+
+        PreClipper(SoftClippingPreampAudioProcessor& processor, const juce::dsp::ProcessSpec& spec, bool)
+        {
+            chain.prepare(spec);
+            chain.get<1>().setCoefficients(0, *processor.makeLowPass2(processor.getSettings())[0]);
+
+            chain.get<0>().setRampDurationSeconds(0.05);
+            chain.get<0>().setGainDecibels(-6.f);
+        }
+
+        juce::dsp::Gain<float>& getGain() noexcept      { return chain.get<0>(); }
+    };
+
+    // The stages after the clipper
+    struct PostClipper
+    {
+        juce::dsp::ProcessorChain<FilterCascade<4>, juce::dsp::Gain<float>> chain;
+        static constexpr float movedDecibels = 3.f;
+
+        PostClipper(SoftClippingPreampAudioProcessor& processor, const juce::dsp::ProcessSpec& spec, bool highShelf)
+        {
+            auto settings = processor.getSettings();
+            auto& filters = chain.get<0>();
+
+            chain.prepare(spec);
+            filters.setCoefficients(0, *processor.makeLowPass2(settings)[0]);
+            filters.setCoefficients(1, *processor.makeHighShelf(settings));
+            filters.setCoefficients(2, *processor.makeToneStackFilter(settings)[0]);
+            filters.setCoefficients(3, *processor.makeToneStackFilter(settings)[1]);
+            filters.setBypassed(1, ! highShelf);
+
+            chain.get<1>().setRampDurationSeconds(0.05);
+            chain.get<1>().setGainDecibels(-6.f);
+        }
+
+        juce::dsp::Gain<float>& getGain() noexcept      { return chain.get<1>(); }
+    };
+
+    // Runs the stages block by block, the gain moving halfway so the ramp is covered too
+    template <typename Stages, typename ProcessFn>
+    void run(Stages& stages, juce::AudioBuffer<float>& buffer, int blockSize, ProcessFn&& process)
+    {
+        for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+        {
+            if (start >= buffer.getNumSamples() / 2 && start - blockSize < buffer.getNumSamples() / 2)
+                stages.getGain().setGainDecibels(Stages::movedDecibels);
+
+            auto numSamples = juce::jmin(blockSize, buffer.getNumSamples() - start);
+            juce::dsp::AudioBlock<float> block(buffer.getArrayOfWritePointers(), 1, (size_t)start, (size_t)numSamples);
+            process(block);
+        }
+    }
+
+    // The staged chain against the fused pass on the same designs and signal: the largest sample
+    // difference, how far the difference's energy is below the staged output's, and both times
+    template <typename Stages, typename FusedFn>
+    bool check(const juce::String& name, SoftClippingPreampAudioProcessor& processor, const juce::dsp::ProcessSpec& spec,
+               const juce::AudioBuffer<float>& input, bool highShelf, double maxDecibels, FusedFn&& processFusedStages)
+    {
+        auto blockSize = (int)spec.maximumBlockSize;
+        Stages staged(processor, spec, highShelf), fused(processor, spec, highShelf);
+        juce::AudioBuffer<float> a(input), b(input);
+
+        auto processStaged = [&] (juce::dsp::AudioBlock<float>& block) {
+            staged.chain.process(juce::dsp::ProcessContextReplacing<float>(block));
+        };
+
+        auto processFusedBlock = [&] (juce::dsp::AudioBlock<float>& block) {
+            processFusedStages(fused, block.getChannelPointer(0), block.getNumSamples());
+        };
+
+        run(staged, a, blockSize, processStaged);
+        run(fused, b, blockSize, processFusedBlock);
+
+        float maxError = 0;
+        double signal = 0, difference = 0;
+
+        for (int i = 0; i < input.getNumSamples(); ++i)
+        {
+            auto r = a.getSample(0, i), o = b.getSample(0, i);
+            maxError = juce::jmax(maxError, std::abs(r - o));
+            signal += (double)r * r;
+            difference += ((double)r - o) * ((double)r - o);
+        }
+
+        auto decibels = juce::Decibels::gainToDecibels(std::sqrt(difference / juce::jmax(signal, 1.0e-30)), -200.0);
+
+        // Timed on the same stages, from the same signal each run
+        juce::AudioBuffer<float> work(1, input.getNumSamples());
+
+        auto stagedSeconds = timeBestOf(numRuns, [&] {
+            work.copyFrom(0, 0, input, 0, 0, input.getNumSamples());
+            run(staged, work, blockSize, processStaged);
+        });
+
+        auto fusedSeconds = timeBestOf(numRuns, [&] {
+            work.copyFrom(0, 0, input, 0, 0, input.getNumSamples());
+            run(fused, work, blockSize, processFusedBlock);
+        });
+
+        auto perSample = [&] (double seconds) { return juce::String(seconds * 1.0e9 / input.getNumSamples(), 2) + " ns/sample"; };
+
+        std::cout << name.paddedRight(' ', 52) << "max difference " << juce::String(juce::Decibels::gainToDecibels(maxError, -200.f), 1)
+                  << " dB, " << juce::String(decibels, 1) << " dB below   staged " << perSample(stagedSeconds)
+                  << "   fused " << perSample(fusedSeconds) << std::endl;
+
+        return decibels <= maxDecibels;
+    }
+}
+
+void runFusedBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    SoftClippingPreampAudioProcessor processor;
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32)blockSize, 1 };
+    auto input = makeTestSignal(sampleRate, (int)sampleRate * 2);
+
+    std::cout << "Fused passes against the staged chain, " << sampleRate << " Hz, " << blockSize << " sample blocks, "
+              << SimdKernels::get().name << " kernels" << std::endl;
+
+    // The per sample passes run the same arithmetic in the same order, so only rounding may differ.
+    // The dispatched cascade kernel may use FMA, which the instruction sets are allowed to differ by.
+    constexpr double perSampleDecibels = -120.0;
+    auto failed = false;
+
+    // Input and LowPass, measured as processChain does
+    failed = ! check<PreClipper>("Input, LowPass, metered", processor, spec, input, false, perSampleDecibels,
+                                 [] (PreClipper& stages, float* data, size_t numSamples) {
+        LevelSums sums;
+        MeterTap meter { sums, 1.f };
+        processFused(data, numSamples, stages.chain.get<0>(), stages.chain.get<1>(), meter);
+    }) || failed;
+
+    for (auto highShelf : { false, true })
+    {
+        auto suffix = highShelf ? ", high shelf" : ", high shelf bypassed";
+
+        failed = ! check<PostClipper>(juce::String("ToneFilters, Volume per sample") + suffix, processor, spec, input, highShelf,
+                                      perSampleDecibels, [] (PostClipper& stages, float* data, size_t numSamples) {
+            processFused(data, numSamples, stages.chain.get<0>(), stages.chain.get<1>());
+        }) || failed;
+
+        // what processChain runs, the dispatched kernel whenever the volume holds still
+        failed = ! check<PostClipper>(juce::String("ToneFilters, Volume as processChain") + suffix, processor, spec, input, highShelf,
+                                      SimdKernels::maxDifferenceDecibels, [] (PostClipper& stages, float* data, size_t numSamples) {
+            LevelSums sums;
+            processFusedCascade(data, numSamples, stages.chain.get<0>(), stages.chain.get<1>(), sums);
+        }) || failed;
+    }
+
+    if (failed)
+        juce::ConsoleApplication::fail("A fused pass doesn't match the staged chain");
+}
@@ -0,0 +1,239 @@
+/*
+  ==============================================================================
+
+    IsaBenchmark.cpp
+    Created: 25 Oct 2026 11:37:08am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/SimdKernels.h"
+
+namespace
+{
+    constexpr int numRuns = 5;
+
+    // One kernel run over the same input by every instruction set
+    struct Result
+    {
+        double seconds { 0 };
+        double differenceDecibels { -200 };
+    };
+
+    // Energy of the difference to the baseline's output, relative to the baseline's
+    double relativeDifference(const std::vector<float>& baseline, const std::vector<float>& other)
+    {
+        double signal = 0, difference = 0;
+
+        for (size_t i = 0; i < baseline.size(); ++i)
+        {
+            signal += (double)baseline[i] * baseline[i];
+            difference += ((double)baseline[i] - other[i]) * ((double)baseline[i] - other[i]);
+        }
+
+        return juce::Decibels::gainToDecibels(std::sqrt(difference / juce::jmax(signal, 1.0e-30)), -200.0);
+    }
+
+    // Runs fn(kernels, output) for each set, from the same input each time
+    template <typename Fn>
+    std::vector<Result> compare(const std::vector<const SimdKernels*>& sets, const std::vector<float>& input, Fn&& fn)
+    {
+        std::vector<Result> results;
+        std::vector<float> baseline;
+
+        for (auto* kernels : sets)
+        {
+            auto output = input;
+            fn(*kernels, output);
+
+            if (baseline.empty())
+                baseline = output;
+
+            Result result;
+            result.differenceDecibels = relativeDifference(baseline, output);
+            result.seconds = timeBestOf(numRuns, [&] {
+                output = input;
+                fn(*kernels, output);
+            });
+
+            results.push_back(result);
+        }
+
+        return results;
+    }
+
+    std::vector<float> toVector(const juce::AudioBuffer<float>& buffer)
+    {
+        return { buffer.getReadPointer(0), buffer.getReadPointer(0) + buffer.getNumSamples() };
+    }
+}
+
+void runIsaBenchmark(const juce::ArgumentList& args)
+{
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    std::vector<const SimdKernels*> sets;
+
+    for (auto isa : { SimdKernels::Isa::baseline, SimdKernels::Isa::avx2, SimdKernels::Isa::avx512 })
+        if (auto* kernels = SimdKernels::getFor(isa))
+            sets.push_back(kernels);
+
+    std::cout << "Kernels for each instruction set this CPU has, against the baseline. The plugin runs "
+              << SimdKernels::get().name << "." << std::endl;
+
+    // The plugin falls back to the best set quietly when the one asked for isn't there
+    auto requested = juce::SystemStats::getEnvironmentVariable("SOFTCLIPPINGPREAMP_ISA", {}).trim().toLowerCase();
+    const char* isaNames[SimdKernels::numIsas] = { "baseline", "avx2", "avx512" };
+
+    if (requested.isNotEmpty() && requested != isaNames[(int)SimdKernels::get().isa])
+        std::cout << "SOFTCLIPPINGPREAMP_ISA=" << requested << " isn't available on this build or CPU, it was ignored." << std::endl;
+
+    auto worst = -200.0;
+
+    auto report = [&] (const juce::String& name, const std::vector<Result>& results, double numSamples)
+    {
+        std::cout << name.paddedRight(' ', 24);
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            std::cout << sets[i]->name << " " << juce::String(results[i].seconds * 1.0e9 / numSamples, 2) << " ns";
+
+            if (i > 0)
+            {
+                std::cout << " (" << juce::String(results[0].seconds / results[i].seconds, 1) << "x, "
+                          << juce::String(results[i].differenceDecibels, 1) << " dB)";
+                worst = juce::jmax(worst, results[i].differenceDecibels);
+            }
+
+            std::cout << "   ";
+        }
+
+        std::cout << std::endl;
+    };
+
+    // Clipper curves, at a drive from the middle of the knob
+    {
+        auto signal = toVector(makeTestSignal(48000.0, 48000));
+        auto names = ClipperStage::getTypeNames();
+
+        for (int curve = 0; curve < SimdKernels::numCurves; ++curve)
+        {
+            auto results = compare(sets, signal, [&] (const SimdKernels& kernels, std::vector<float>& data) {
+                for (size_t i = 0; i < data.size(); i += (size_t)blockSize)
+                    kernels.clip[curve](data.data() + i, data.data() + i, juce::jmin((size_t)blockSize, data.size() - i), 100.f);
+            });
+
+            report("Clipper " + names[curve], results, (double)signal.size());
+        }
+    }
+
+    // The tone filters and the volume with the plugin's designs, where the float filters are at their worst too
+    {
+        SoftClippingPreampAudioProcessor processor;
+
+        for (auto sampleRate : { 48000.0, 192000.0 })
+        {
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+
+            auto settings = processor.getSettings();
+            auto toneStack = processor.makeToneStackFilter(settings);
+            auto signal = toVector(makeTestSignal(sampleRate, (int)sampleRate));
+
+            auto results = compare(sets, signal, [&] (const SimdKernels& kernels, std::vector<float>& data) {
+                FilterCascade<4> cascade;
+                cascade.setCoefficients(0, *processor.makeLowPass2(settings)[0]);
+                cascade.setCoefficients(1, *processor.makeHighShelf(settings));
+                cascade.setCoefficients(2, *toneStack[0]);
+                cascade.setCoefficients(3, *toneStack[1]);
+
+                for (size_t i = 0; i < data.size(); i += (size_t)blockSize)
+                {
+                    FilterCascade<4>::Kernel kernel(cascade);
+                    SimdKernels::Levels input;
+                    kernels.cascade(data.data() + i, juce::jmin((size_t)blockSize, data.size() - i), kernel.b, kernel.a, kernel.s, 0.5f, input);
+                    kernel.finish();
+                }
+            });
+
+            report("Tone filters " + juce::String((int)(sampleRate / 1000)) + " kHz", results, (double)signal.size());
+
+            // The same designs over streams side by side, as BatchEngine runs them. Each stream starts
+            // somewhere else in the signal, 16 lanes fill a register of every set.
+            constexpr size_t numLanes = 16;
+            std::vector<float> frames(signal.size() * numLanes);
+
+            for (size_t i = 0; i < signal.size(); ++i)
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                    frames[i * numLanes + lane] = signal[(i + lane * 101) % signal.size()];
+
+            FilterCascade<3> laneDesign;
+            laneDesign.setCoefficients(0, *processor.makeLowPass2(settings)[0]);
+            laneDesign.setCoefficients(1, *toneStack[0]);
+            laneDesign.setCoefficients(2, *toneStack[1]);
+
+            auto laneResults = compare(sets, frames, [&] (const SimdKernels& kernels, std::vector<float>& data) {
+                alignas(64) float state[3 * 2 * numLanes] = {};
+                FilterCascade<3>::Kernel kernel(laneDesign);
+                auto numFrames = data.size() / numLanes;
+
+                for (size_t i = 0; i < numFrames; i += (size_t)blockSize)
+                    kernels.laneCascade(data.data() + i * numLanes, juce::jmin((size_t)blockSize, numFrames - i), numLanes,
+                                        kernel.b, kernel.a, state, 3, 0.5f);
+            });
+
+            report("Lane filters " + juce::String((int)(sampleRate / 1000)) + " kHz", laneResults, (double)frames.size());
+        }
+    }
+
+    // Output gain
+    {
+        auto signal = toVector(makeTestSignal(48000.0, 48000));
+
+        auto results = compare(sets, signal, [&] (const SimdKernels& kernels, std::vector<float>& data) {
+            for (size_t i = 0; i < data.size(); i += (size_t)blockSize)
+                kernels.multiply(data.data() + i, juce::jmin((size_t)blockSize, data.size() - i), 0.7f);
+        });
+
+        report("Gain", results, (double)signal.size());
+
+        // and measured in the same pass, as the Output position runs it
+        auto measuredResults = compare(sets, signal, [&] (const SimdKernels& kernels, std::vector<float>& data) {
+            SimdKernels::Levels output;
+
+            for (size_t i = 0; i < data.size(); i += (size_t)blockSize)
+                kernels.multiplyAndMeasure(data.data() + i, juce::jmin((size_t)blockSize, data.size() - i), 0.7f, output);
+        });
+
+        report("Gain, measured", measuredResults, (double)signal.size());
+    }
+
+    // The cabinet tail's spectra, a second of 1024 sample partitions, per bin
+    {
+        constexpr int numBins = 1025, numPartitions = 48;
+
+        juce::Random random(1);
+        std::vector<float> spectra((size_t)(numBins * 2 * numPartitions)), filters(spectra.size());
+
+        for (auto* v : { &spectra, &filters })
+            for (auto& s : *v)
+                s = random.nextFloat() * 2.f - 1.f;
+
+        auto results = compare(sets, std::vector<float>((size_t)numBins * 2, 0.f), [&] (const SimdKernels& kernels, std::vector<float>& acc) {
+            for (int k = 0; k < numPartitions; ++k)
+                kernels.complexMultiplyAccumulate(acc.data(), spectra.data() + k * numBins * 2, filters.data() + k * numBins * 2, (size_t)numBins);
+        });
+
+        report("Spectrum multiply-add", results, (double)(numBins * numPartitions));
+    }
+
+    std::cout << "Times per sample, per complex bin for the multiply-add. Largest difference " << juce::String(worst, 1)
+              << " dB, allowed " << SimdKernels::maxDifferenceDecibels << " dB" << std::endl;
+
+    if (worst > SimdKernels::maxDifferenceDecibels)
+        juce::ConsoleApplication::fail("An instruction set's kernels don't match the baseline");
+}
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    LayoutBenchmark.cpp
+    Created: 30 Oct 2026 10:14:37am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+#include <set>
+
+namespace
+{
+    constexpr int numRuns = 401;
+    constexpr int cacheLine = 64;
+
+    // Cache lines a set of address ranges covers
+    struct Lines
+    {
+        std::set<std::uintptr_t> lines;
+
+        void add(const void* start, size_t numBytes)
+        {
+            auto first = (std::uintptr_t)start / cacheLine;
+            auto last = ((std::uintptr_t)start + numBytes - 1) / cacheLine;
+
+            for (auto line = first; line <= last; ++line)
+                lines.insert(line);
+        }
+    };
+
+    // Writes over more memory than the caches hold, so the next block starts cold
+    void evictCaches(std::vector<float>& scratch)
+    {
+        for (size_t i = 0; i < scratch.size(); i += cacheLine / sizeof(float))
+            scratch[i] += 1.f;
+    }
+
+    // The median time of one block, each run after the caches got evicted
+    template <typename ProcessFn>
+    double timeColdBlock(std::vector<float>& scratch, ProcessFn&& process)
+    {
+        std::vector<double> times;
+
+        for (int run = 0; run < numRuns; ++run)
+        {
+            evictCaches(scratch);
+
+            auto start = juce::Time::getHighResolutionTicks();
+            process();
+            times.push_back(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+        }
+
+        std::nth_element(times.begin(), times.begin() + numRuns / 2, times.end());
+        return times[numRuns / 2];
+    }
+}
+
+void runLayoutBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 32;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    SoftClippingPreampAudioProcessor processor;
+    auto settings = processor.getSettings();
+
+    // The five filter sections the chain runs per channel, with the plugin's designs
+    juce::Array<juce::dsp::IIR::Coefficients<float>::Ptr> designs { processor.makeLowPass2(settings)[0],
+                                                                    processor.makeLowPass2(settings)[0],
+                                                                    processor.makeHighShelf(settings),
+                                                                    processor.makeToneStackFilter(settings)[0],
+                                                                    processor.makeToneStackFilter(settings)[1] };
+
+    juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32)blockSize, 1 };
+
+    // As the chain held them before FilterCascade: a juce::dsp::IIR::Filter per section, each
+    // sharing a reference counted design and keeping its state in a heap block of its own
+    std::array<juce::dsp::IIR::Filter<float>, 5> filters;
+
+    for (size_t i = 0; i < filters.size(); ++i)
+    {
+        filters[i].coefficients = designs[(int)i];
+        filters[i].prepare(spec);
+    }
+
+    // As they are now, inline in the chain
+    FilterCascade<1> lowPass;
+    FilterCascade<4> toneFilters;
+    lowPass.prepare(spec);
+    toneFilters.prepare(spec);
+    lowPass.setCoefficients(0, *designs[0]);
+
+    for (int i = 1; i < designs.size(); ++i)
+        toneFilters.setCoefficients((size_t)i - 1, *designs[i]);
+
+    // The filters' state isn't reachable from outside, one line each is the least it takes
+    Lines before, after;
+
+    for (auto& filter : filters)
+    {
+        before.add(&filter, sizeof(filter));
+        before.add(filter.coefficients.get(), sizeof(juce::dsp::IIR::Coefficients<float>));
+        before.add(filter.coefficients->coefficients.begin(), (size_t)filter.coefficients->coefficients.size() * sizeof(float));
+    }
+
+    auto numBefore = before.lines.size() + filters.size();
+
+    after.add(&lowPass, sizeof(lowPass));
+    after.add(&toneFilters, sizeof(toneFilters));
+
+    auto signal = makeTestSignal(sampleRate, blockSize);
+    juce::AudioBuffer<float> work(1, blockSize);
+    std::vector<float> scratch((size_t)64 * 1024 * 1024 / sizeof(float), 0.f);
+
+    auto processBlock = [&] (auto&&... stages) {
+        work.copyFrom(0, 0, signal, 0, 0, blockSize);
+        juce::dsp::AudioBlock<float> block(work);
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        (stages.process(context), ...);
+    };
+
+    auto beforeSeconds = timeColdBlock(scratch, [&] { processBlock(filters[0], filters[1], filters[2], filters[3], filters[4]); });
+    auto afterSeconds = timeColdBlock(scratch, [&] { processBlock(lowPass, toneFilters); });
+
+    std::cout << "Filter sections of one channel, " << sampleRate << " Hz, " << blockSize << " sample blocks from cold caches" << std::endl;
+    std::cout << "  juce::dsp::IIR::Filter  " << numBefore << " cache lines, " << filters.size() << " heap blocks and "
+              << filters.size() << " designs on the heap, " << juce::String(beforeSeconds * 1.0e9, 0) << " ns" << std::endl;
+    std::cout << "  FilterCascade           " << after.lines.size() << " cache lines in 2 runs inside the chain, "
+              << sizeof(lowPass) << " + " << sizeof(toneFilters) << " bytes, " << juce::String(afterSeconds * 1.0e9, 0) << " ns" << std::endl;
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    LightCabinetBenchmark.cpp
+    Created: 27 Oct 2026 3:05:12pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/CabinetFit.h"
+
+namespace
+{
+    constexpr double maxFitErrorDecibels = 3.0;
+    constexpr double maxLevelDifferenceDecibels = 3.0;
+
+    // Runs the signal through a cabinet in blocks and returns the seconds it took
+    double render(const juce::AudioBuffer<float>& response, double responseSampleRate, juce::AudioBuffer<float>& buffer,
+                  double sampleRate, int blockSize, bool light)
+    {
+        // Offline the tail and the fit run in line, so neither depends on other threads
+        CabinetConvolution cabinet;
+        cabinet.setNonRealtime(true);
+        cabinet.prepare({ sampleRate, (juce::uint32)blockSize, 1 });
+        cabinet.loadImpulseResponse(response, responseSampleRate);
+        cabinet.setLightMode(light);
+
+        // the fit happens on the first block, which isn't timed
+        juce::AudioBuffer<float> silence(1, blockSize);
+        silence.clear();
+        juce::dsp::AudioBlock<float> warmUp(silence);
+        cabinet.process(juce::dsp::ProcessContextReplacing<float>(warmUp));
+        cabinet.reset();
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int position = 0; position < buffer.getNumSamples(); position += blockSize)
+        {
+            auto subBlock = block.getSubBlock((size_t)position, (size_t)juce::jmin(blockSize, buffer.getNumSamples() - position));
+            cabinet.process(juce::dsp::ProcessContextReplacing<float>(subBlock));
+        }
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    }
+
+    double getEnergy(const juce::AudioBuffer<float>& buffer)
+    {
+        double sum = 0;
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            sum += (double)buffer.getSample(0, i) * buffer.getSample(0, i);
+
+        return sum;
+    }
+}
+
+void runLightCabinetBenchmark(const juce::ArgumentList& args)
+{
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 64;
+    auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 10.0;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    // The mic blend an instance starts with, from the responses in Resources
+    SoftClippingPreampAudioProcessor processor;
+    processor.setRateAndBufferSizeDetails(48000.0, blockSize);
+    processor.prepareToPlay(48000.0, blockSize);
+
+    auto response = processor.makeCabinetResponse(processor.getSettings());
+    auto responseSampleRate = processor.getCabinetSampleRate();
+
+    if (response.getNumSamples() == 0 || responseSampleRate <= 0)
+    {
+        juce::ConsoleApplication::fail("No cabinet response in Resources");
+        return;
+    }
+
+    auto fitStart = juce::Time::getHighResolutionTicks();
+    auto fit = CabinetFit::fit(response.getReadPointer(0), response.getNumSamples(), responseSampleRate);
+    auto fitSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - fitStart);
+
+    std::cout << "Light cabinet for the default mic blend, " << fit.sections.size() << " sections fitted in "
+              << juce::String(fitSeconds * 1000.0, 1) << " ms, " << juce::String(fit.errorDecibels, 2)
+              << " dB RMS from the smoothed response" << std::endl;
+    std::cout << "Times per sample with " << blockSize << " sample blocks" << std::endl;
+
+    auto worstLevel = 0.0;
+
+    for (auto sampleRate : { 44100.0, 48000.0, 96000.0 })
+    {
+        auto signal = makeTestSignal(sampleRate, (int)(seconds * sampleRate));
+
+        juce::AudioBuffer<float> convolved(signal), light(signal);
+        auto convolutionSeconds = render(response, responseSampleRate, convolved, sampleRate, blockSize, false);
+        auto lightSeconds = render(response, responseSampleRate, light, sampleRate, blockSize, true);
+
+        // The fit matches the level of the response, so the two should come out about as loud
+        auto level = juce::Decibels::gainToDecibels(std::sqrt(getEnergy(light) / juce::jmax(getEnergy(convolved), 1.0e-30)), -200.0);
+        worstLevel = juce::jmax(worstLevel, std::abs(level));
+
+        auto numSamples = (double)signal.getNumSamples();
+
+        std::cout << juce::String(sampleRate / 1000.0, 1).paddedRight(' ', 6) << "kHz   convolution "
+                  << juce::String(convolutionSeconds * 1.0e9 / numSamples, 1) << " ns   light "
+                  << juce::String(lightSeconds * 1.0e9 / numSamples, 1) << " ns ("
+                  << juce::String(convolutionSeconds / lightSeconds, 1) << "x)   level "
+                  << juce::String(level, 2) << " dB" << std::endl;
+    }
+
+    if (fit.errorDecibels > maxFitErrorDecibels)
+        juce::ConsoleApplication::fail("The fit is too far from the cabinet response");
+
+    if (worstLevel > maxLevelDifferenceDecibels)
+        juce::ConsoleApplication::fail("The light cabinet doesn't match the level of the convolution");
+}
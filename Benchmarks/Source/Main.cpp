@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Benchmarks.h"
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand("--help|-h", "SoftClippingPreamp benchmarks", true);
+
+    app.addCommand({ "clipper",
+                     "clipper [--rate <Hz>] [--block <samples>]",
+                     "Per sample cost of the clipper curves and the diode clipper",
+                     "Runs every clipper type over the same signal and reports ns per sample, "
+                     "relative to the std::function atan waveshaper the plugin used to run.",
+                     [] (const juce::ArgumentList& args) { runClipperBenchmark(args); } });
+
+    app.addCommand({ "stress",
+                     "stress [--rate <Hz>] [--block <samples>] [--max <instances>] [--seconds <s>]",
+                     "How many plugin instances fit in one audio callback",
+                     "Runs more and more instances with random settings in one simulated callback until one "
+                     "takes longer than the block lasts. Reports callback time percentiles against the deadline, "
+                     "the largest instance count without a miss and the resident memory per instance.",
+                     [] (const juce::ArgumentList& args) { runStressBenchmark(args); } });
+
+    app.addCommand({ "verify",
+                     "verify [--rate <Hz>] [--block <samples>]",
+                     "Checks the fused passes against the staged chain",
+                     "Runs the input level and the low pass before the clipper, and the filters and the volume after "
+                     "it, both as separate processors and the way processChain fuses them, with the plugin's designs "
+                     "and a gain ramp. Fails when the outputs differ, and reports the cost of both.",
+                     [] (const juce::ArgumentList& args) { runFusedBenchmark(args); } });
+
+    app.addCommand({ "offline",
+                     "offline [--rate <Hz>] [--block <samples>] [--seconds <s>]",
+                     "Offline render with the channels in parallel and one after the other",
+                     "Renders a stereo signal through the plugin as a bounce would, once with the right channel "
+                     "on the worker pool and once without. Fails when the outputs differ, and reports both times.",
+                     [] (const juce::ArgumentList& args) { runOfflineBenchmark(args); } });
+
+    app.addCommand({ "tonestack",
+                     "tonestack [--block <samples>]",
+                     "Precision and cost of the tone stack sections",
+                     "Runs the tone stack's biquad and first order section in float at 44.1, 96 and 192 kHz, and "
+                     "the same design as one third order section, against both in double. Fails when the sections "
+                     "lose more than 60 dB, and reports the cost of both.",
+                     [] (const juce::ArgumentList& args) { runToneStackBenchmark(args); } });
+
+    app.addCommand({ "isa",
+                     "isa [--block <samples>]",
+                     "Checks the AVX2 and AVX-512 kernels against the baseline ones",
+                     "Runs the clipper curves, the tone filters, the output gain and the cabinet's spectrum multiply-add "
+                     "with every instruction set this CPU has. Fails when one differs from the baseline by more than "
+                     "SimdKernels allows, and reports the cost of each.",
+                     [] (const juce::ArgumentList& args) { runIsaBenchmark(args); } });
+
+    app.addCommand({ "batch",
+                     "batch [--rate <Hz>] [--block <samples>] [--streams <count>] [--seconds <s>]",
+                     "Many streams with the same settings through the batch engine",
+                     "Renders mono streams through one BatchEngine and through plugin instances, two streams each. "
+                     "Fails when the outputs differ with the baseline kernels, or by more than SimdKernels allows with "
+                     "the active ones, and reports the throughput of both.",
+                     [] (const juce::ArgumentList& args) { runBatchBenchmark(args); } });
+
+    app.addCommand({ "lightcab",
+                     "lightcab [--block <samples>] [--seconds <s>]",
+                     "The light cabinet against the convolution",
+                     "Fits the default mic blend with biquads and reports how far the fit is from the response, then runs "
+                     "both cabinets at 44.1, 48 and 96 kHz. Fails when the fit is more than 3 dB RMS off or the two differ "
+                     "in level by more than 3 dB, and reports the cost of both.",
+                     [] (const juce::ArgumentList& args) { runLightCabinetBenchmark(args); } });
+
+    app.addCommand({ "measure",
+                     "measure [--rate <Hz>] [--block <samples>] [--clipper <index>] [--json <file>]",
+                     "Quality and cost of each processing mode",
+                     "Runs sines at 1, 5 and 10 kHz and 16 tones through the quality tiers, ADAA and the light cabinet at "
+                     "three drives. Reports THD+N and aliasing to signal ratio, the level at each tone against the same "
+                     "designs run in double at 64x, the latency the phase shows against the reported one, and the cost. "
+                     "--json writes all of it to a file.",
+                     [] (const juce::ArgumentList& args) { runMeasureBenchmark(args); } });
+
+    app.addCommand({ "bypass",
+                     "bypass [--rate <Hz>] [--block <samples>] [--seconds <s>]",
+                     "Toggling the bypass, and what a bypassed instance costs",
+                     "Toggles the bypass parameter during a render. Fails when the bypassed output isn't exactly the input "
+                     "delayed by the reported latency, or a toggle steps further than the signals do on their own. Then "
+                     "times a running instance against a bypassed one.",
+                     [] (const juce::ArgumentList& args) { runBypassBenchmark(args); } });
+
+    app.addCommand({ "meters",
+                     "meters [--rate <Hz>] [--block <samples>]",
+                     "The level meters against the signal, and what metering costs",
+                     "Runs steady tones through instances and fails when the input and output meters are more than "
+                     "a quarter of a dB from the buffers, when the clipper activity doesn't follow the drive, or when "
+                     "the metered passes cost more than 5% of an instance over the plain ones.",
+                     [] (const juce::ArgumentList& args) { runMeterBenchmark(args); } });
+
+    app.addCommand({ "layout",
+                     "layout [--rate <Hz>] [--block <samples>]",
+                     "Where the filter sections' coefficients and state live",
+                     "Counts the cache lines one channel's filter sections take as the chain's FilterCascades and as "
+                     "juce::dsp::IIR::Filters with the same designs, and times a short block through each from cold caches.",
+                     [] (const juce::ArgumentList& args) { runLayoutBenchmark(args); } });
+
+    app.addCommand({ "dualmono",
+                     "dualmono [--rate <Hz>] [--block <samples>]",
+                     "Checks the right chain picks up from the left one when dual mono ends",
+                     "Renders the same signal on both channels until one chain runs for both, then makes the right "
+                     "channel quieter. Fails when the right output, once faded back, differs from an instance whose "
+                     "right chain never stopped by more than -60 dB.",
+                     [] (const juce::ArgumentList& args) { runDualMonoBenchmark(args); } });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,655 @@
+/*
+  ==============================================================================
+
+    MeasureBenchmark.cpp
+    Created: 28 Oct 2026 10:12:40am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/Constants.h"
+
+namespace
+{
+    using Complex = std::complex<double>;
+
+    // The reference runs the clipping stages this many times faster than the plugin's rate, in double
+    constexpr int referenceOversampling = 64;
+
+    // Every measurement is one window of this many samples, after the chain has settled. The signals
+    // repeat every window and each tone sits on a prime bin of it, so no harmonic, alias or
+    // intermodulation product of one tone lands on the bin of another's harmonics.
+    constexpr int windowSize = 1 << 16;
+
+    // Processing modes to compare, each one against the same reference
+    struct Mode
+    {
+        const char* name;
+        Quality quality;
+        bool adaa, lightCabinet;
+    };
+
+    const Mode modes[] =
+    {
+        { "Eco",                        Quality::Eco,       false,  false },
+        { "Standard",                   Quality::Standard,  false,  false },
+        { "High",                       Quality::High,      false,  false },
+        { "Standard, ADAA",             Quality::Standard,  true,   false },
+        { "Standard, light cabinet",    Quality::Standard,  false,  true }
+    };
+
+    const float drives[] = { 11.f, 50.f, 250.f };
+
+    struct Tone
+    {
+        int bin;
+        double amplitude, phase;
+    };
+
+    // In place, the size a power of two
+    void fft(std::vector<Complex>& data)
+    {
+        auto n = data.size();
+
+        for (size_t i = 1, j = 0; i < n; ++i)
+        {
+            auto bit = n >> 1;
+
+            for (; (j & bit) != 0; bit >>= 1)
+                j ^= bit;
+
+            j ^= bit;
+
+            if (i < j)
+                std::swap(data[i], data[j]);
+        }
+
+        std::vector<Complex> twiddles(n / 2);
+
+        for (size_t k = 0; k < twiddles.size(); ++k)
+            twiddles[k] = std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * (double)k / (double)n);
+
+        for (size_t length = 2; length <= n; length <<= 1)
+        {
+            auto stride = n / length;
+
+            for (size_t start = 0; start < n; start += length)
+            {
+                for (size_t k = 0; k < length / 2; ++k)
+                {
+                    auto a = data[start + k];
+                    auto b = data[start + k + length / 2] * twiddles[k * stride];
+                    data[start + k] = a + b;
+                    data[start + k + length / 2] = a - b;
+                }
+            }
+        }
+    }
+
+    bool isPrime(int n)
+    {
+        if (n < 2)
+            return false;
+
+        for (int d = 2; d * d <= n; ++d)
+            if (n % d == 0)
+                return false;
+
+        return true;
+    }
+
+    // The nearest prime bin to a frequency that isn't taken yet
+    int toPrimeBin(double frequency, double sampleRate, std::vector<int>& taken)
+    {
+        auto target = juce::jmax(3, (int)std::round(frequency * windowSize / sampleRate));
+
+        for (int offset = 0;; ++offset)
+        {
+            for (auto bin : { target - offset, target + offset })
+            {
+                if (isPrime(bin) && std::find(taken.begin(), taken.end(), bin) == taken.end())
+                {
+                    taken.push_back(bin);
+                    return bin;
+                }
+            }
+        }
+    }
+
+    double toFrequency(int bin, double sampleRate)
+    {
+        return bin * sampleRate / windowSize;
+    }
+
+    // The response of a filter design at a frequency, in double
+    Complex evaluate(const juce::dsp::IIR::Coefficients<float>& coefficients, double frequency, double sampleRate)
+    {
+        auto& c = coefficients.coefficients;
+        auto order = (c.size() - 1) / 2;
+        auto z = std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * frequency / sampleRate);
+
+        Complex numerator = 0, denominator = 1, power = 1;
+
+        for (int i = 0; i <= order; ++i)
+        {
+            numerator += (double)c[i] * power;
+
+            if (i > 0)
+                denominator += (double)c[order + i] * power;
+
+            power *= z;
+        }
+
+        return numerator / denominator;
+    }
+
+    // Energy ratio in dB, -200 for nothing at all
+    double toDecibels(double energy, double reference)
+    {
+        return juce::Decibels::gainToDecibels(std::sqrt(energy / juce::jmax(reference, 1.0e-30)), -200.0);
+    }
+
+    // The stages up to the cabinet as the plugin designs them, for one set of settings. The clipping
+    // stages run in double at referenceOversampling times the rate, fed the steady state of the
+    // Input and LowPass positions. The linear positions after them are applied per bin, the
+    // cabinet from the response as the plugin bakes it, before its resampling and truncation.
+    class Reference
+    {
+    public:
+        Reference(SoftClippingPreampAudioProcessor& designer, double rate)
+            : settings(designer.getSettings()), sampleRate(rate),
+              snapshot(designer.makeSnapshot(settings)),
+              cabinet(designer.makeCabinetResponse(settings)), cabinetSampleRate(designer.getCabinetSampleRate())
+        {
+            // The mix comes normalised, CabinetConvolution keeps its energy at the plugin's rate
+            cabinetGain = hasCabinet() ? std::sqrt(sampleRate / cabinetSampleRate) : 0.0;
+        }
+
+        bool hasCabinet() const noexcept    { return cabinet.getNumSamples() > 0 && cabinetSampleRate > 0; }
+        double getCabinetSeconds() const    { return cabinet.getNumSamples() / cabinetSampleRate; }
+
+        Complex getInputGain(int bin) const
+        {
+            return (double)juce::Decibels::decibelsToGain(settings.input_level)
+                 * evaluate(*snapshot->lowPass, toFrequency(bin, sampleRate), sampleRate);
+        }
+
+        Complex getOutputGain(int bin) const
+        {
+            auto frequency = toFrequency(bin, sampleRate);
+            auto gain = (double)juce::Decibels::decibelsToGain(settings.volume) * juce::Decibels::decibelsToGain(settings.output_level)
+                      * evaluate(*snapshot->lowPass2, frequency, sampleRate);
+
+            // the high shelf is always bypassed
+            for (auto* section : snapshot->toneStack)
+                gain *= evaluate(*section, frequency, sampleRate);
+
+            Complex response = 0, z = 1;
+            auto step = std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * frequency / cabinetSampleRate);
+
+            for (int i = 0; i < cabinet.getNumSamples(); ++i)
+            {
+                response += (double)cabinet.getSample(0, i) * z;
+                z *= step;
+            }
+
+            return gain * cabinetGain * response;
+        }
+
+        // The clipping stages' output over one window, the bins below the plugin's Nyquist
+        std::vector<Complex> render(const std::vector<Tone>& tones) const
+        {
+            auto rate = sampleRate * referenceOversampling;
+            auto length = (size_t)windowSize * referenceOversampling;
+            auto settle = (int)(0.05 * rate);
+
+            // One rotating phasor per tone, starting settle samples before the window
+            std::vector<Complex> phasors, steps;
+
+            for (auto& tone : tones)
+            {
+                auto gain = getInputGain(tone.bin);
+                auto omega = 2.0 * juce::MathConstants<double>::pi * tone.bin / (double)length;
+
+                phasors.push_back(std::polar(tone.amplitude * std::abs(gain), tone.phase + std::arg(gain) - omega * settle));
+                steps.push_back(std::polar(1.0, omega));
+            }
+
+            auto highPass = OnePole::highPass(ClipperCascade::interstageHighPassFrequency, rate);
+            auto lowPass = OnePole::lowPass(ClipperCascade::interstageLowPassFrequency, rate);
+            std::array<Interstage, ClipperCascade::maxStages - 1> interstage {};
+
+            auto type = (ClipperType)settings.clipper_type;
+            auto numStages = juce::jlimit(1, ClipperCascade::maxStages, settings.gain_stages);
+
+            std::vector<Complex> output(length);
+
+            for (int n = -settle; n < (int)length; ++n)
+            {
+                double x = 0;
+
+                for (size_t k = 0; k < phasors.size(); ++k)
+                {
+                    x += phasors[k].imag();
+                    phasors[k] *= steps[k];
+                }
+
+                x = shape(type, settings.drive * x) + x;
+
+                for (int stage = 1; stage < numStages; ++stage)
+                {
+                    x = interstage[(size_t)stage - 1].process(x, highPass, lowPass);
+                    x = shape(type, settings.stage_drive * x) + x;
+                }
+
+                if (n >= 0)
+                    output[(size_t)n] = x;
+            }
+
+            fft(output);
+
+            output.resize((size_t)windowSize / 2);
+
+            for (auto& bin : output)
+                bin /= (double)length;
+
+            return output;
+        }
+
+    private:
+        struct OnePole
+        {
+            double b0, b1, a1;
+
+            static OnePole highPass(double frequency, double rate)
+            {
+                auto k = std::tan(juce::MathConstants<double>::pi * frequency / rate);
+                return { 1.0 / (1.0 + k), -1.0 / (1.0 + k), (k - 1.0) / (k + 1.0) };
+            }
+
+            static OnePole lowPass(double frequency, double rate)
+            {
+                auto k = std::tan(juce::MathConstants<double>::pi * frequency / rate);
+                return { k / (1.0 + k), k / (1.0 + k), (k - 1.0) / (k + 1.0) };
+            }
+        };
+
+        struct Interstage
+        {
+            double highPassX1, highPassY1, lowPassX1, lowPassY1;
+
+            double process(double x, const OnePole& highPass, const OnePole& lowPass)
+            {
+                auto h = highPass.b0 * x + highPass.b1 * highPassX1 - highPass.a1 * highPassY1;
+                highPassX1 = x;
+                highPassY1 = h;
+
+                auto l = lowPass.b0 * h + lowPass.b1 * lowPassX1 - lowPass.a1 * lowPassY1;
+                lowPassX1 = h;
+                lowPassY1 = l;
+
+                return l * ClipperCascade::interstageGain;
+            }
+        };
+
+        // The exact curves of clippers::, in double
+        static double shape(ClipperType type, double u)
+        {
+            switch (type)
+            {
+            case ClipperType::Atan:         return 2.0 / juce::MathConstants<double>::pi * std::atan(u);
+            case ClipperType::Tanh:         return std::tanh(u);
+            case ClipperType::Cubic:        { auto x = juce::jlimit(-1.0, 1.0, u); return 1.5 * x - 0.5 * x * x * x; }
+            case ClipperType::Hard:         return juce::jlimit(-1.0, 1.0, u);
+            case ClipperType::Asymmetric:   return juce::jlimit((double)clippers::Asymmetric::negativeLimit, 1.0, u);
+            default:                        jassertfalse; return 0.0;
+            }
+        }
+
+        Settings settings;
+        double sampleRate;
+        std::unique_ptr<DspSnapshot> snapshot;
+        juce::AudioBuffer<float> cabinet;
+        double cabinetSampleRate, cabinetGain { 0 };
+    };
+
+    void setParameter(SoftClippingPreampAudioProcessor& processor, const juce::String& id, float value)
+    {
+        auto* parameter = processor.m_apvts.getParameter(id);
+        jassert(parameter != nullptr);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    // An instance with everything but the measured parameters at their defaults. Realtime, so the
+    // quality tier isn't raised to High as it is for a bounce.
+    std::unique_ptr<SoftClippingPreampAudioProcessor> makeProcessor(const Mode& mode, float drive, int clipper, double sampleRate, int blockSize)
+    {
+        auto processor = std::make_unique<SoftClippingPreampAudioProcessor>();
+
+        setParameter(*processor, Parameters::k_drive, drive);
+        setParameter(*processor, Parameters::k_clipper_type, (float)clipper);
+        setParameter(*processor, Parameters::k_quality, (float)mode.quality);
+        setParameter(*processor, Parameters::k_clipper_adaa, mode.adaa ? 1.f : 0.f);
+        setParameter(*processor, Parameters::k_light_cabinet, mode.lightCabinet ? 1.f : 0.f);
+
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        // the convolution loads in the background, the light cabinet gets fitted there
+        juce::Thread::sleep(500);
+
+        return processor;
+    }
+
+    struct Render
+    {
+        std::vector<Complex> spectrum;
+        double seconds { 0 };
+        int numSamples { 0 };
+    };
+
+    // The tones through the plugin in blocks for numPeriods windows to settle, then the spectrum of one more
+    Render render(SoftClippingPreampAudioProcessor& processor, const std::vector<Tone>& tones, int numPeriods, int blockSize)
+    {
+        Render result;
+        result.numSamples = (numPeriods + 1) * windowSize;
+
+        juce::AudioBuffer<float> buffer(2, result.numSamples);
+
+        for (int n = 0; n < result.numSamples; ++n)
+        {
+            double x = 0;
+
+            for (auto& tone : tones)
+                x += tone.amplitude * std::sin(2.0 * juce::MathConstants<double>::pi * tone.bin * (n % windowSize) / windowSize + tone.phase);
+
+            buffer.setSample(0, n, (float)x);
+            buffer.setSample(1, n, (float)x);
+        }
+
+        juce::MidiBuffer midi;
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int position = 0; position < result.numSamples; position += blockSize)
+        {
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, position, juce::jmin(blockSize, result.numSamples - position));
+            processor.processBlock(block, midi);
+        }
+
+        result.seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        std::vector<Complex> window((size_t)windowSize);
+
+        for (int i = 0; i < windowSize; ++i)
+            window[(size_t)i] = buffer.getSample(0, numPeriods * windowSize + i);
+
+        fft(window);
+
+        window.resize((size_t)windowSize / 2);
+
+        for (auto& bin : window)
+            bin /= (double)windowSize;
+
+        result.spectrum = std::move(window);
+        return result;
+    }
+
+    // Of one sine, all relative to the output's energy
+    struct SineResult
+    {
+        double thdPlusNoise, aliasing;
+    };
+
+    SineResult measureSine(const std::vector<Complex>& spectrum, int bin)
+    {
+        double total = 0, harmonics = 0;
+
+        // DC is left out, the post clipper low pass removes what the curves add
+        for (size_t b = 1; b < spectrum.size(); ++b)
+            total += std::norm(spectrum[b]);
+
+        for (size_t b = (size_t)bin; b < spectrum.size(); b += (size_t)bin)
+            harmonics += std::norm(spectrum[b]);
+
+        auto fundamental = std::norm(spectrum[(size_t)bin]);
+
+        return { toDecibels(total - fundamental, total), toDecibels(total - harmonics, harmonics) };
+    }
+
+    // The harmonics of the reference against its fundamental, after the linear stages
+    double measureReferenceThd(const Reference& reference, const std::vector<Complex>& spectrum, int bin)
+    {
+        double fundamental = 0, distortion = 0;
+
+        for (size_t b = (size_t)bin; b < spectrum.size(); b += (size_t)bin)
+        {
+            auto energy = std::norm(spectrum[b] * reference.getOutputGain((int)b));
+
+            if (b == (size_t)bin)
+                fundamental = energy;
+            else
+                distortion += energy;
+        }
+
+        return toDecibels(distortion, fundamental + distortion);
+    }
+
+    struct ResponseResult
+    {
+        double maxDeviation, rmsDeviation, latency;
+    };
+
+    // Level against the reference at every tone, and the delay from how the phase difference grows with
+    // frequency below a sixteenth of the rate, where the oversampling filters' phase is still linear
+    ResponseResult measureResponse(const Reference& reference, const std::vector<Complex>& referenceSpectrum,
+                                   const std::vector<Complex>& spectrum, std::vector<Tone> tones)
+    {
+        std::sort(tones.begin(), tones.end(), [] (const Tone& a, const Tone& b) { return a.bin < b.bin; });
+
+        ResponseResult result { 0, 0, 0 };
+        double sumOfSquares = 0, numerator = 0, denominator = 0;
+
+        for (auto& tone : tones)
+        {
+            auto expected = referenceSpectrum[(size_t)tone.bin] * reference.getOutputGain(tone.bin);
+            auto measured = spectrum[(size_t)tone.bin];
+
+            auto deviation = juce::Decibels::gainToDecibels(std::abs(measured) / juce::jmax(std::abs(expected), 1.0e-30), -200.0);
+            result.maxDeviation = juce::jmax(result.maxDeviation, std::abs(deviation));
+            sumOfSquares += deviation * deviation;
+
+            if (tone.bin < windowSize / 16)
+            {
+                // unwrapped towards the delay found from the tones below
+                auto omega = 2.0 * juce::MathConstants<double>::pi * tone.bin / windowSize;
+                auto phase = std::arg(measured) - std::arg(expected);
+                phase -= juce::MathConstants<double>::twoPi * std::round((phase + omega * result.latency) / juce::MathConstants<double>::twoPi);
+
+                numerator += omega * phase;
+                denominator += omega * omega;
+                result.latency = -numerator / denominator;
+            }
+        }
+
+        result.rmsDeviation = std::sqrt(sumOfSquares / (double)tones.size());
+        return result;
+    }
+}
+
+void runMeasureBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+    auto clipper = args.containsOption("--clipper") ? args.getValueForOption("--clipper").getIntValue() : 0;
+    auto jsonFile = args.containsOption("--json") ? args.getFileForOption("--json") : juce::File();
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    if (! juce::isPositiveAndBelow(clipper, (int)ClipperType::Diode))
+    {
+        juce::ConsoleApplication::fail("The reference has the static curves only, --clipper 0 to "
+                                       + juce::String((int)ClipperType::Diode - 1));
+        return;
+    }
+
+    // Sines low, in the middle and high, where the aliasing is worst, and tones across the band
+    std::vector<int> taken;
+    std::vector<std::vector<Tone>> sines;
+
+    for (auto frequency : { 1000.0, 5000.0, 10000.0 })
+        sines.push_back({ { toPrimeBin(juce::jmin(frequency, 0.45 * sampleRate), sampleRate, taken), 0.5, 0.0 } });
+
+    std::vector<Tone> multitone;
+    juce::Random random(1);
+    constexpr int numTones = 16;
+
+    for (int i = 0; i < numTones; ++i)
+    {
+        auto frequency = 40.0 * std::pow(juce::jmin(16000.0, 0.4 * sampleRate) / 40.0, i / (numTones - 1.0));
+        multitone.push_back({ toPrimeBin(frequency, sampleRate, taken), 0.1, random.nextDouble() * juce::MathConstants<double>::twoPi });
+    }
+
+    std::cout << "Each mode against a double reference at " << referenceOversampling << "x, " << sampleRate << " Hz, "
+              << blockSize << " sample blocks, " << ClipperStage::getTypeNames()[clipper] << " clipper, "
+              << SimdKernels::get().name << " kernels" << std::endl;
+    std::cout << "Sines at";
+
+    for (auto& sine : sines)
+        std::cout << " " << juce::String(toFrequency(sine[0].bin, sampleRate), 0);
+
+    std::cout << " Hz, " << numTones << " tones for the response and the latency" << std::endl;
+
+    auto results = juce::var(juce::Array<juce::var>());
+    std::vector<double> modeSeconds(std::size(modes), 0.0), modeSamples(std::size(modes), 0.0);
+    std::vector<int> reportedLatencies(std::size(modes), 0);
+
+    for (auto drive : drives)
+    {
+        // Designed by an instance with the same settings, the modes don't change any design
+        auto designer = makeProcessor(modes[1], drive, clipper, sampleRate, blockSize);
+        Reference reference(*designer, sampleRate);
+
+        if (! reference.hasCabinet())
+        {
+            juce::ConsoleApplication::fail("No cabinet response in Resources");
+            return;
+        }
+
+        // until the cabinet has rung out, in whole windows so the signals start in phase
+        auto numPeriods = (int)std::ceil((reference.getCabinetSeconds() + 0.25) * sampleRate / windowSize);
+
+        std::vector<std::vector<Complex>> sineReferences;
+
+        for (auto& sine : sines)
+            sineReferences.push_back(reference.render(sine));
+
+        auto multitoneReference = reference.render(multitone);
+
+        auto driveResult = new juce::DynamicObject();
+        driveResult->setProperty("drive", drive);
+
+        std::cout << std::endl << "Drive " << drive << ", the reference's THD";
+        auto referenceThd = juce::var(juce::Array<juce::var>());
+
+        for (size_t i = 0; i < sines.size(); ++i)
+        {
+            auto thd = measureReferenceThd(reference, sineReferences[i], sines[i][0].bin);
+            referenceThd.append(thd);
+            std::cout << " " << juce::String(thd, 1);
+        }
+
+        std::cout << " dB" << std::endl;
+        driveResult->setProperty("referenceThdDecibels", referenceThd);
+
+        auto modeResults = juce::var(juce::Array<juce::var>());
+
+        for (size_t m = 0; m < std::size(modes); ++m)
+        {
+            auto processor = makeProcessor(modes[m], drive, clipper, sampleRate, blockSize);
+            reportedLatencies[m] = processor->getLatencySamples();
+
+            double seconds = 0;
+            int numSamples = 0;
+
+            auto modeResult = new juce::DynamicObject();
+            modeResult->setProperty("mode", modes[m].name);
+
+            auto sineResults = juce::var(juce::Array<juce::var>());
+            juce::String thdText, aliasingText;
+
+            for (auto& sine : sines)
+            {
+                auto output = render(*processor, sine, numPeriods, blockSize);
+                seconds += output.seconds;
+                numSamples += output.numSamples;
+
+                auto measured = measureSine(output.spectrum, sine[0].bin);
+                thdText << " " << juce::String(measured.thdPlusNoise, 1);
+                aliasingText << " " << juce::String(measured.aliasing, 1);
+
+                auto sineResult = new juce::DynamicObject();
+                sineResult->setProperty("frequency", toFrequency(sine[0].bin, sampleRate));
+                sineResult->setProperty("thdPlusNoiseDecibels", measured.thdPlusNoise);
+                sineResult->setProperty("aliasingDecibels", measured.aliasing);
+                sineResults.append(juce::var(sineResult));
+            }
+
+            auto output = render(*processor, multitone, numPeriods, blockSize);
+            seconds += output.seconds;
+            numSamples += output.numSamples;
+
+            auto response = measureResponse(reference, multitoneReference, output.spectrum, multitone);
+            auto nsPerSample = seconds * 1.0e9 / numSamples;
+
+            modeSeconds[m] += seconds;
+            modeSamples[m] += numSamples;
+
+            modeResult->setProperty("sines", sineResults);
+            modeResult->setProperty("maxResponseDeviationDecibels", response.maxDeviation);
+            modeResult->setProperty("rmsResponseDeviationDecibels", response.rmsDeviation);
+            modeResult->setProperty("measuredLatencySamples", response.latency);
+            modeResult->setProperty("reportedLatencySamples", reportedLatencies[m]);
+            modeResult->setProperty("nanosecondsPerSample", nsPerSample);
+            modeResults.append(juce::var(modeResult));
+
+            std::cout << "  " << juce::String(modes[m].name).paddedRight(' ', 24) << "THD+N" << thdText << " dB   aliasing"
+                      << aliasingText << " dB   response " << juce::String(response.maxDeviation, 2) << " dB max, "
+                      << juce::String(response.rmsDeviation, 2) << " dB rms   latency " << juce::String(response.latency, 2)
+                      << " (" << reportedLatencies[m] << ")   " << juce::String(nsPerSample, 1) << " ns/sample" << std::endl;
+        }
+
+        driveResult->setProperty("modes", modeResults);
+        results.append(juce::var(driveResult));
+    }
+
+    if (jsonFile != juce::File())
+    {
+        auto summary = juce::var(juce::Array<juce::var>());
+
+        for (size_t m = 0; m < std::size(modes); ++m)
+        {
+            auto mode = new juce::DynamicObject();
+            mode->setProperty("mode", modes[m].name);
+            mode->setProperty("reportedLatencySamples", reportedLatencies[m]);
+            mode->setProperty("nanosecondsPerSample", modeSeconds[m] * 1.0e9 / modeSamples[m]);
+            summary.append(juce::var(mode));
+        }
+
+        auto root = new juce::DynamicObject();
+        root->setProperty("sampleRate", sampleRate);
+        root->setProperty("blockSize", blockSize);
+        root->setProperty("clipper", ClipperStage::getTypeNames()[clipper]);
+        root->setProperty("kernels", SimdKernels::get().name);
+        root->setProperty("referenceOversampling", referenceOversampling);
+        root->setProperty("modes", summary);
+        root->setProperty("drives", results);
+
+        if (! jsonFile.replaceWithText(juce::JSON::toString(juce::var(root))))
+            juce::ConsoleApplication::fail("Couldn't write " + jsonFile.getFullPathName());
+
+        std::cout << std::endl << "Written to " << jsonFile.getFullPathName() << std::endl;
+    }
+}
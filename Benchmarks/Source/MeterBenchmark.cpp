@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    MeterBenchmark.cpp
+    Created: 29 Oct 2026 2:38:19pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/Constants.h"
+
+namespace
+{
+    constexpr int numRuns = 5;
+
+    // Readings for a steady tone have to land this close to what the buffers hold
+    constexpr float maxLevelErrorDecibels = 0.25f;
+
+    // The metering's share of what a whole instance costs
+    constexpr double maxCostPercent = 5.0;
+
+    void render(SoftClippingPreampAudioProcessor& processor, juce::AudioBuffer<float>& buffer, int blockSize)
+    {
+        juce::MidiBuffer midi;
+
+        for (int position = 0; position < buffer.getNumSamples(); position += blockSize)
+        {
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), position,
+                                           juce::jmin(blockSize, buffer.getNumSamples() - position));
+            processor.processBlock(block, midi);
+        }
+    }
+
+    juce::AudioBuffer<float> makeTone(double sampleRate, int numSamples, float amplitude)
+    {
+        juce::AudioBuffer<float> tone(2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto sample = amplitude * (float)std::sin(juce::MathConstants<double>::twoPi * 223.0 * i / sampleRate);
+            tone.setSample(0, i, sample);
+            tone.setSample(1, i, sample);
+        }
+
+        return tone;
+    }
+
+    float getDecibels(const LevelMeter& meter, bool peak)
+    {
+        return juce::Decibels::gainToDecibels(peak ? meter.getPeak() : meter.getRms(), -200.f);
+    }
+
+    float getHostMeter(SoftClippingPreampAudioProcessor& processor, const juce::String& id)
+    {
+        for (auto* parameter : processor.getParameters())
+            if (auto* meter = dynamic_cast<MeterParameter*>(parameter); meter != nullptr && meter->paramID == id)
+                return meter->getReading();
+
+        return 0;
+    }
+}
+
+void runMeterBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    auto prepare = [&] (SoftClippingPreampAudioProcessor& processor, float drive)
+    {
+        processor.m_apvts.getParameter(Parameters::k_drive)->setValueNotifyingHost(drive);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    };
+
+    std::cout << "Meters at " << sampleRate << " Hz, " << blockSize << " sample blocks" << std::endl;
+
+    // A steady tone, long enough for the averages to settle: quiet with the least drive, which
+    // shouldn't clip at all, and at -6 dBFS with the most, which should clip most of the time.
+    // The last half second is what the readings get checked against.
+    auto numSamples = (int)(sampleRate * 2);
+    auto tail = (int)(sampleRate * 0.5);
+    auto failed = false;
+
+    float quietActivity = 0, loudActivity = 0;
+
+    for (auto [drive, amplitude] : { std::make_pair(0.f, 0.005f), std::make_pair(1.f, 0.5f) })
+    {
+        SoftClippingPreampAudioProcessor processor;
+        prepare(processor, drive);
+        juce::Thread::sleep(500);
+
+        auto input = makeTone(sampleRate, numSamples, amplitude);
+        juce::AudioBuffer<float> output(input);
+        render(processor, output, blockSize);
+
+        auto& meters = processor.getMeters();
+        (drive == 0.f ? quietActivity : loudActivity) = meters.preClipper.getActivity();
+
+        auto check = [&] (const char* name, const LevelMeter& meter, const juce::AudioBuffer<float>& buffer)
+        {
+            auto peak = buffer.getMagnitude(numSamples - tail, tail);
+            auto rms = std::sqrt(0.5f * (juce::square(buffer.getRMSLevel(0, numSamples - tail, tail))
+                                         + juce::square(buffer.getRMSLevel(1, numSamples - tail, tail))));
+
+            auto peakError = getDecibels(meter, true) - juce::Decibels::gainToDecibels(peak, -200.f);
+            auto rmsError = getDecibels(meter, false) - juce::Decibels::gainToDecibels(rms, -200.f);
+
+            std::cout << "  " << juce::String(name).paddedRight(' ', 8) << "peak " << juce::String(getDecibels(meter, true), 2)
+                      << " dB (" << juce::String(peakError, 3) << ")   RMS " << juce::String(getDecibels(meter, false), 2)
+                      << " dB (" << juce::String(rmsError, 3) << ")" << std::endl;
+
+            failed = failed || std::abs(peakError) > maxLevelErrorDecibels || std::abs(rmsError) > maxLevelErrorDecibels;
+        };
+
+        std::cout << "Drive at " << (drive == 0.f ? "its minimum" : "its maximum") << ", tone at "
+                  << juce::Decibels::gainToDecibels(amplitude) << " dBFS, against the buffers" << std::endl;
+        check("Input", meters.input, input);
+        check("Output", meters.output, output);
+
+        std::cout << "  Clipper activity " << juce::String(meters.preClipper.getActivity() * 100.f, 1) << "%, host meters: input "
+                  << juce::String(getHostMeter(processor, Parameters::k_input_meter), 1) << " dB, output "
+                  << juce::String(getHostMeter(processor, Parameters::k_output_meter), 1) << " dB, clipping "
+                  << juce::String(getHostMeter(processor, Parameters::k_clipping_meter), 1) << "%" << std::endl;
+
+        // the host's meters read the same atomics, only clipped to their range
+        auto hostError = getHostMeter(processor, Parameters::k_input_meter) - getDecibels(meters.input, true);
+        failed = failed || std::abs(hostError) > 1.f;
+
+        // a host that could automate them would write to them
+        for (auto* parameter : processor.getParameters())
+            failed = failed || (dynamic_cast<MeterParameter*>(parameter) != nullptr && parameter->isAutomatable());
+    }
+
+    // The cost, a whole instance against the passes the meters ride along in with and without them.
+    // The tone filters' kernel and the dry delay always measure, what that costs is only in the instance's time.
+    auto signal = makeTestSignal(sampleRate, numSamples);
+
+    SoftClippingPreampAudioProcessor processor;
+    prepare(processor, 0.5f);
+    juce::Thread::sleep(500);
+
+    juce::AudioBuffer<float> stereo(2, numSamples), work;
+    stereo.copyFrom(0, 0, signal, 0, 0, numSamples);
+    stereo.copyFrom(1, 0, signal, 0, 0, numSamples);
+    stereo.applyGain(1, 0, numSamples, 0.9f);   // so both chains run
+
+    auto instanceSeconds = timeBestOf(numRuns, [&] {
+        work.makeCopyOf(stereo, true);
+        render(processor, work, blockSize);
+    });
+
+    juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32)blockSize, 1 };
+    juce::dsp::Gain<float> inputGain;
+    FilterCascade<1> lowPass;
+    inputGain.prepare(spec);
+    inputGain.setGainDecibels(6.f);
+    lowPass.prepare(spec);
+    lowPass.setCoefficients(0, *processor.makeLowPass2(processor.getSettings())[0]);
+
+    auto& kernels = SimdKernels::get();
+
+    auto forEachBlock = [&] (auto&& process) {
+        work.makeCopyOf(signal, true);
+        auto* data = work.getWritePointer(0);
+
+        for (int position = 0; position < numSamples; position += blockSize)
+            process(data + position, (size_t)juce::jmin(blockSize, numSamples - position));
+    };
+
+    auto fusedSeconds = timeBestOf(numRuns, [&] {
+        forEachBlock([&] (float* block, size_t n) { processFused(block, n, inputGain, lowPass); });
+    });
+
+    auto fusedMeteredSeconds = timeBestOf(numRuns, [&] {
+        forEachBlock([&] (float* block, size_t n) {
+            LevelSums sums;
+            MeterTap meter { sums, 0.1f };
+            processFused(block, n, inputGain, lowPass, meter);
+        });
+    });
+
+    auto gainSeconds = timeBestOf(numRuns, [&] {
+        forEachBlock([&] (float* block, size_t n) { kernels.multiply(block, n, 0.7f); });
+    });
+
+    auto gainMeteredSeconds = timeBestOf(numRuns, [&] {
+        forEachBlock([&] (float* block, size_t n) {
+            SimdKernels::Levels levels;
+            kernels.multiplyAndMeasure(block, n, 0.7f, levels);
+        });
+    });
+
+    // per sample of one channel, both chains run
+    auto perSample = [&] (double s) { return s * 1.0e9 / numSamples; };
+    auto instance = perSample(instanceSeconds) / 2;
+    auto fusedCost = perSample(fusedMeteredSeconds - fusedSeconds);
+    auto gainCost = perSample(gainMeteredSeconds - gainSeconds);
+    auto costPercent = 100.0 * juce::jmax(0.0, fusedCost + gainCost) / instance;
+
+    std::cout << "Times per sample, " << kernels.name << " kernels" << std::endl;
+    std::cout << "  Instance, per channel          " << juce::String(instance, 2) << " ns" << std::endl;
+    std::cout << "  Input, LowPass                 " << juce::String(perSample(fusedSeconds), 2) << " ns, metered "
+              << juce::String(perSample(fusedMeteredSeconds), 2) << " ns" << std::endl;
+    std::cout << "  Output gain                    " << juce::String(perSample(gainSeconds), 2) << " ns, metered "
+              << juce::String(perSample(gainMeteredSeconds), 2) << " ns" << std::endl;
+    std::cout << "  Metering adds about " << juce::String(costPercent, 2) << "% to an instance" << std::endl;
+
+    if (quietActivity > 0.01f || loudActivity < 0.5f)
+        juce::ConsoleApplication::fail("The clipper activity doesn't follow the drive");
+
+    if (failed)
+        juce::ConsoleApplication::fail("The meters don't match the signal");
+
+    if (costPercent > maxCostPercent)
+        juce::ConsoleApplication::fail("Metering costs too much");
+}
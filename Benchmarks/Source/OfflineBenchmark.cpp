@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    OfflineBenchmark.cpp
+    Created: 23 Oct 2026 5:12:44pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    // Renders the whole signal offline, block by block, and returns the seconds it took
+    double render(juce::AudioBuffer<float>& buffer, double sampleRate, int blockSize, bool parallel)
+    {
+        SoftClippingPreampAudioProcessor processor;
+        processor.setNonRealtime(true);
+        processor.setParallelOfflineChannels(parallel);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        // The cabinet's mic blend gets baked in the background, both runs should start with it
+        juce::Thread::sleep(500);
+
+        juce::MidiBuffer midi;
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int position = 0; position < buffer.getNumSamples(); position += blockSize)
+        {
+            auto numSamples = juce::jmin(blockSize, buffer.getNumSamples() - position);
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, position, numSamples);
+            processor.processBlock(block, midi);
+        }
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    }
+}
+
+void runOfflineBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 4096;
+    auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 10.0;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    // The right channel lags the left, so the plugin doesn't fall back to running one chain
+    auto numSamples = (int)(seconds * sampleRate);
+    auto mono = makeTestSignal(sampleRate, numSamples);
+    auto lag = (int)(sampleRate * 0.01);
+
+    juce::AudioBuffer<float> input(2, numSamples);
+    input.copyFrom(0, 0, mono, 0, 0, numSamples);
+    input.clear(1, 0, lag);
+    input.copyFrom(1, lag, mono, 0, 0, numSamples - lag);
+
+    std::cout << "Offline render of " << seconds << " s of stereo, " << sampleRate << " Hz, " << blockSize << " sample blocks" << std::endl;
+
+    if (blockSize < (int)SoftClippingPreampAudioProcessor::parallelBlockSize)
+        std::cout << "Blocks under " << SoftClippingPreampAudioProcessor::parallelBlockSize
+                  << " samples always run the channels one after the other" << std::endl;
+
+    juce::AudioBuffer<float> sequential(input), parallel(input);
+
+    auto sequentialSeconds = render(sequential, sampleRate, blockSize, false);
+    auto parallelSeconds = render(parallel, sampleRate, blockSize, true);
+
+    float maxError = 0;
+
+    for (int channel = 0; channel < 2; ++channel)
+        for (int i = 0; i < numSamples; ++i)
+            maxError = juce::jmax(maxError, std::abs(sequential.getSample(channel, i) - parallel.getSample(channel, i)));
+
+    std::cout << "One after the other   " << juce::String(sequentialSeconds, 3) << " s   "
+              << juce::String(seconds / sequentialSeconds, 1) << "x realtime" << std::endl;
+    std::cout << "In parallel           " << juce::String(parallelSeconds, 3) << " s   "
+              << juce::String(seconds / parallelSeconds, 1) << "x realtime, max difference "
+              << juce::Decibels::gainToDecibels(maxError, -200.f) << " dB" << std::endl;
+
+    if (maxError > 1.0e-5f)
+        juce::ConsoleApplication::fail("The parallel render doesn't match the sequential one");
+}
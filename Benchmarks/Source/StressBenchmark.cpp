@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    StressBenchmark.cpp
+    Created: 21 Oct 2026 3:14:08pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+ #include <psapi.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#endif
+
+namespace
+{
+    constexpr int numWarmupCallbacks = 20;
+
+    // Resident memory of the whole process, 0 where we can't tell
+    size_t getResidentBytes()
+    {
+       #if JUCE_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters;
+
+        if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return (size_t)counters.WorkingSetSize;
+       #elif JUCE_MAC
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+            return (size_t)info.resident_size;
+       #elif JUCE_LINUX
+        auto pages = juce::StringArray::fromTokens(juce::File("/proc/self/statm").loadFileAsString(), true);
+
+        if (pages.size() > 1)
+            return (size_t)pages[1].getLargeIntValue() * (size_t)sysconf(_SC_PAGESIZE);
+       #endif
+
+        return 0;
+    }
+
+    struct CallbackTimes
+    {
+        std::vector<double> seconds;
+        int numMisses { 0 };
+
+        double percentile(double p) const
+        {
+            auto sorted = seconds;
+            auto index = juce::jlimit((size_t)0, sorted.size() - 1, (size_t)(p * (double)(sorted.size() - 1) + 0.5));
+            std::nth_element(sorted.begin(), sorted.begin() + (std::ptrdiff_t)index, sorted.end());
+            return sorted[index];
+        }
+    };
+
+    class InstanceRack
+    {
+    public:
+        InstanceRack(double newSampleRate, int newBlockSize, const juce::AudioBuffer<float>& newSignal)
+            : sampleRate(newSampleRate), blockSize(newBlockSize), signal(newSignal), buffer(2, newBlockSize)
+        {
+        }
+
+        size_t size() const noexcept    { return instances.size(); }
+
+        // Adds instances with random settings, prepared and ready to run
+        void growTo(size_t numInstances)
+        {
+            while (instances.size() < numInstances)
+            {
+                auto instance = std::make_unique<SoftClippingPreampAudioProcessor>();
+
+                // a bypassed instance would hardly cost anything
+                for (auto* parameter : instance->getParameters())
+                    if (parameter != instance->getBypassParameter())
+                        parameter->setValueNotifyingHost(random.nextFloat());
+
+                instance->setRateAndBufferSizeDetails(sampleRate, blockSize);
+                instance->prepareToPlay(sampleRate, blockSize);
+                instances.push_back(std::move(instance));
+            }
+        }
+
+        // The first numInstances once per callback, the way a host runs a set of tracks on one audio thread
+        CallbackTimes run(size_t numInstances, int numCallbacks)
+        {
+            CallbackTimes times;
+            times.seconds.reserve((size_t)numCallbacks);
+
+            auto deadline = blockSize / sampleRate;
+
+            for (int callback = -numWarmupCallbacks; callback < numCallbacks; ++callback)
+            {
+                auto start = juce::Time::getHighResolutionTicks();
+
+                for (size_t i = 0; i < numInstances; ++i)
+                {
+                    for (int channel = 0; channel < 2; ++channel)
+                        buffer.copyFrom(channel, 0, signal, 0, position, blockSize);
+
+                    instances[i]->processBlock(buffer, midi);
+                }
+
+                auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+                position = (position + blockSize) % (signal.getNumSamples() - blockSize);
+
+                if (callback < 0)
+                    continue;
+
+                times.seconds.push_back(elapsed);
+
+                if (elapsed > deadline)
+                    ++times.numMisses;
+            }
+
+            return times;
+        }
+
+    private:
+        double sampleRate;
+        int blockSize;
+        const juce::AudioBuffer<float>& signal;
+
+        std::vector<std::unique_ptr<SoftClippingPreampAudioProcessor>> instances;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+        juce::Random random { 4321 };
+        int position { 0 };
+    };
+}
+
+void runStressBenchmark(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 128;
+    auto maxInstances = args.containsOption("--max") ? args.getValueForOption("--max").getIntValue() : 512;
+    auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 2.0;
+
+    // The processors post to the message thread, which needs to exist even if it never runs here
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    auto signal = makeTestSignal(sampleRate, (int)sampleRate * 4);
+    auto numCallbacks = juce::jmax(1, (int)(seconds * sampleRate / blockSize));
+    auto deadline = blockSize / sampleRate;
+
+    std::cout << "Instances sharing one " << blockSize << " sample callback at " << sampleRate << " Hz, deadline "
+              << juce::String(deadline * 1000.0, 3) << " ms, " << numCallbacks << " callbacks each" << std::endl;
+
+    InstanceRack rack(sampleRate, blockSize, signal);
+
+    auto report = [&] (int numInstances) {
+        rack.growTo((size_t)numInstances);
+        auto times = rack.run((size_t)numInstances, numCallbacks);
+
+        auto percent = [deadline] (double s) { return juce::String(100.0 * s / deadline, 1) + "%"; };
+
+        std::cout << juce::String(numInstances).paddedLeft(' ', 5) << " instances   p50 " << percent(times.percentile(0.5))
+                  << "   p99 " << percent(times.percentile(0.99)) << "   p99.9 " << percent(times.percentile(0.999))
+                  << "   max " << percent(times.percentile(1.0)) << "   misses " << times.numMisses << std::endl;
+
+        return times.numMisses == 0;
+    };
+
+    auto memoryBefore = getResidentBytes();
+
+    // Double until a deadline goes missing, then bisect between the last count that held and that one
+    int sustained = 0, failed = 0;
+
+    for (int n = 1; ; n = juce::jmin(n * 2, maxInstances))
+    {
+        if (! report(n))
+        {
+            failed = n;
+            break;
+        }
+
+        sustained = n;
+
+        if (n >= maxInstances)
+            break;
+    }
+
+    // Instances only get added, the bisection runs the first n of what the doubling created
+    while (failed > sustained + 1)
+    {
+        auto n = (sustained + failed) / 2;
+
+        if (report(n))
+            sustained = n;
+        else
+            failed = n;
+    }
+
+    auto memoryAfter = getResidentBytes();
+
+    if (failed == 0)
+        std::cout << "No deadline missed up to " << sustained << " instances" << std::endl;
+    else
+        std::cout << "Sustainable: " << sustained << " instances" << std::endl;
+
+    if (memoryBefore > 0 && memoryAfter > memoryBefore)
+        std::cout << "Memory: " << juce::String((double)(memoryAfter - memoryBefore) / (double)rack.size() / 1024.0, 1)
+                  << " kB per instance, resident" << std::endl;
+}
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    ToneStackBenchmark.cpp
+    Created: 24 Oct 2026 10:06:21am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int numRuns = 5;
+
+    // Coefficients as FilterCascade takes them apart: b0..bN, a1..aN
+    using Polynomials = std::pair<std::vector<double>, std::vector<double>>;
+
+    Polynomials getPolynomials(const juce::dsp::IIR::Coefficients<float>& coefficients)
+    {
+        auto order = (int)(coefficients.coefficients.size() - 1) / 2;
+        auto* c = coefficients.coefficients.begin();
+        Polynomials p { std::vector<double>((size_t)order + 1), std::vector<double>((size_t)order + 1, 1.0) };
+
+        for (int i = 0; i <= order; ++i)
+            p.first[(size_t)i] = c[i];
+
+        for (int i = 1; i <= order; ++i)
+            p.second[(size_t)i] = c[order + i];
+
+        return p;
+    }
+
+    std::vector<double> multiply(const std::vector<double>& x, const std::vector<double>& y)
+    {
+        std::vector<double> product(x.size() + y.size() - 1, 0.0);
+
+        for (size_t i = 0; i < x.size(); ++i)
+            for (size_t j = 0; j < y.size(); ++j)
+                product[i + j] += x[i] * y[j];
+
+        return product;
+    }
+
+    // Transposed direct form II of any order, the way FilterCascade runs a section
+    template <typename SampleType>
+    void runDirectForm(const Polynomials& p, SampleType* data, int numSamples)
+    {
+        auto order = p.first.size() - 1;
+        std::vector<SampleType> b(p.first.begin(), p.first.end()), a(p.second.begin(), p.second.end()), s(order + 1, 0);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = data[i];
+            auto y = b[0] * x + s[0];
+
+            for (size_t k = 0; k < order; ++k)
+                s[k] = b[k + 1] * x - a[k + 1] * y + s[k + 1];
+
+            data[i] = y;
+        }
+    }
+
+    // The old single section, three states unrolled like FilterCascade had it
+    void runThirdOrder(const Polynomials& p, float* data, int numSamples)
+    {
+        float b0 = (float)p.first[0], b1 = (float)p.first[1], b2 = (float)p.first[2], b3 = (float)p.first[3];
+        float a1 = (float)p.second[1], a2 = (float)p.second[2], a3 = (float)p.second[3];
+        float s0 = 0, s1 = 0, s2 = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = data[i];
+            auto y = b0 * x + s0;
+
+            s0 = b1 * x - a1 * y + s1;
+            s1 = b2 * x - a2 * y + s2;
+            s2 = b3 * x - a3 * y;
+
+            data[i] = y;
+        }
+    }
+
+    // Error energy against the reference, relative to the reference, after the first 100 ms
+    double relativeError(const std::vector<double>& reference, const float* data, int start)
+    {
+        double signal = 0, error = 0;
+
+        for (size_t i = (size_t)start; i < reference.size(); ++i)
+        {
+            signal += reference[i] * reference[i];
+            error += (data[i] - reference[i]) * (data[i] - reference[i]);
+        }
+
+        return juce::Decibels::gainToDecibels(std::sqrt(error / signal), -200.0);
+    }
+}
+
+void runToneStackBenchmark(const juce::ArgumentList& args)
+{
+    auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    SoftClippingPreampAudioProcessor processor;
+    auto failed = false;
+
+    std::cout << "Tone stack as a biquad and a first order section against one third order section, "
+              << "worst of the bass/middle/treble corners" << std::endl;
+
+    for (auto sampleRate : { 44100.0, 96000.0, 192000.0 })
+    {
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+
+        auto input = makeTestSignal(sampleRate, (int)sampleRate);
+        auto numSamples = input.getNumSamples();
+        auto start = (int)(sampleRate * 0.1);
+
+        double worstCascade = -200, worstThirdOrder = -200, cascadeSeconds = 0, thirdOrderSeconds = 0;
+
+        for (auto knob : { 0.001f, 0.5f, 0.999f })
+        {
+            for (auto* member : { &Settings::low_gain, &Settings::middle_gain, &Settings::treble_gain })
+            {
+                auto settings = processor.getSettings();
+                settings.*member = knob;
+
+                auto sections = processor.makeToneStackFilter(settings);
+                auto biquad = getPolynomials(*sections[0]), firstOrder = getPolynomials(*sections[1]);
+
+                // The same design multiplied out, and both run in double as the reference
+                Polynomials product { multiply(biquad.first, firstOrder.first), multiply(biquad.second, firstOrder.second) };
+
+                std::vector<double> reference(input.getReadPointer(0), input.getReadPointer(0) + numSamples);
+                runDirectForm(biquad, reference.data(), numSamples);
+                runDirectForm(firstOrder, reference.data(), numSamples);
+
+                FilterCascade<2> cascade;
+                cascade.setCoefficients(0, *sections[0]);
+                cascade.setCoefficients(1, *sections[1]);
+
+                juce::AudioBuffer<float> work(1, numSamples);
+
+                auto runCascade = [&] {
+                    work.copyFrom(0, 0, input, 0, 0, numSamples);
+                    cascade.reset();
+
+                    for (int i = 0; i < numSamples; i += blockSize)
+                    {
+                        juce::dsp::AudioBlock<float> block(work.getArrayOfWritePointers(), 1, (size_t)i, (size_t)juce::jmin(blockSize, numSamples - i));
+                        cascade.process(juce::dsp::ProcessContextReplacing<float>(block));
+                    }
+                };
+
+                auto runOld = [&] {
+                    work.copyFrom(0, 0, input, 0, 0, numSamples);
+                    runThirdOrder(product, work.getWritePointer(0), numSamples);
+                };
+
+                runCascade();
+                worstCascade = juce::jmax(worstCascade, relativeError(reference, work.getReadPointer(0), start));
+
+                runOld();
+                worstThirdOrder = juce::jmax(worstThirdOrder, relativeError(reference, work.getReadPointer(0), start));
+
+                cascadeSeconds += timeBestOf(numRuns, runCascade);
+                thirdOrderSeconds += timeBestOf(numRuns, runOld);
+            }
+        }
+
+        auto perSample = [&] (double seconds) { return juce::String(seconds * 1.0e9 / (9.0 * numSamples), 2) + " ns/sample"; };
+
+        std::cout << juce::String((int)sampleRate).paddedLeft(' ', 6) << " Hz   error: sections " << juce::String(worstCascade, 1)
+                  << " dB, third order " << juce::String(worstThirdOrder, 1) << " dB   sections "
+                  << perSample(cascadeSeconds) << ", third order " << perSample(thirdOrderSeconds) << std::endl;
+
+        failed = failed || worstCascade > -60.0;
+    }
+
+    if (failed)
+        juce::ConsoleApplication::fail("The tone stack sections lose too much precision");
+}
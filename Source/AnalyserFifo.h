@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    AnalyserFifo.h
+    Created: 20 Oct 2026 2:15:08pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Carries samples from the audio thread to the editor's analysers. Single producer, single consumer.
+//
+// The audio thread only writes while an editor has it switched on, and never waits: whatever doesn't
+// fit is dropped, the analysers can live with a gap.
+class AnalyserFifo
+{
+public:
+    static constexpr int capacity = 1 << 15;
+
+    // Message thread
+    void setActive(bool shouldBeActive) noexcept    { active.store(shouldBeActive, std::memory_order_release); }
+    bool isActive() const noexcept                  { return active.load(std::memory_order_relaxed); }
+
+    // Audio thread
+    void push(const float* samples, int numSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+        std::copy(samples, samples + size1, buffer.begin() + start1);
+        std::copy(samples + size1, samples + size1 + size2, buffer.begin() + start2);
+
+        fifo.finishedWrite(size1 + size2);
+    }
+
+    // Message thread. Returns how many samples were read.
+    int pull(float* destination, int maxSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(maxSamples, start1, size1, start2, size2);
+
+        std::copy(buffer.begin() + start1, buffer.begin() + start1 + size1, destination);
+        std::copy(buffer.begin() + start2, buffer.begin() + start2 + size2, destination + size1);
+
+        fifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+private:
+    juce::AbstractFifo fifo { capacity };
+    std::vector<float> buffer = std::vector<float>(capacity);
+    std::atomic<bool> active { false };
+};
+
+// A pass-through position of the process chain that copies its channel into an AnalyserFifo
+class AnalyserTap
+{
+public:
+    void setFifo(AnalyserFifo* newFifo) noexcept    { fifo = newFifo; }
+
+    void prepare(const juce::dsp::ProcessSpec&) {}
+    void reset() noexcept {}
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto&& inputBlock = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom(inputBlock);
+
+        if (fifo != nullptr && fifo->isActive())
+            fifo->push(outputBlock.getChannelPointer(0), (int)outputBlock.getNumSamples());
+    }
+
+private:
+    AnalyserFifo* fifo { nullptr };
+};
@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+    BackgroundThread.h
+    Created: 19 Oct 2026 10:04:12am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One low priority thread shared by every plugin instance in the process.
+// Use it through juce::SharedResourcePointer<BackgroundThread> for housekeeping
+// that must stay off the audio thread (freeing retired DSP state, etc.).
+class BackgroundThread : public juce::TimeSliceThread
+{
+public:
+    BackgroundThread() : juce::TimeSliceThread("SoftClippingPreamp background")
+    {
+        startThread(3);
+    }
+
+    ~BackgroundThread() override
+    {
+        stopThread(2000);
+    }
+};
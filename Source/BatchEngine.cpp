@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    BatchEngine.cpp
+    Created: 26 Oct 2026 10:04:18am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "BatchEngine.h"
+#include "Trace.h"
+
+namespace
+{
+    // The widest register any kernel set uses, in bytes
+    constexpr size_t laneAlignment = 64;
+
+    // The lane kernel over a cascade's design, with the lanes' own state
+    template <size_t numSections>
+    void processLanes(const SimdKernels& kernels, FilterCascade<numSections>& design, float* frames, size_t numFrames,
+                      size_t numLanes, float* state, float gain) noexcept
+    {
+        typename FilterCascade<numSections>::Kernel kernel(design);
+        kernels.laneCascade(frames, numFrames, numLanes, kernel.b, kernel.a, state, (int)numSections, gain);
+    }
+}
+
+void BatchEngine::prepare(const DspSnapshot& design, int newNumStreams, int maximumBlockSize, Quality quality)
+{
+    jassert(newNumStreams > 0 && maximumBlockSize > 0);
+    jassert(design.lowPass != nullptr && design.lowPass2 != nullptr && design.toneStack.size() == 2);
+
+    kernels = &SimdKernels::get();
+    numStreams = newNumStreams;
+    numLanes = ((size_t)numStreams + kernels->laneWidth - 1) / kernels->laneWidth * kernels->laneWidth;
+    maximumFrames = (size_t)maximumBlockSize;
+
+    auto& settings = design.settings;
+
+    // as juce::dsp::Gain::setGainDecibels does
+    inputGain = juce::Decibels::decibelsToGain(settings.input_level);
+    volumeGain = juce::Decibels::decibelsToGain(settings.volume);
+    outputGain = juce::Decibels::decibelsToGain(settings.output_level);
+
+    lowPass.setCoefficients(0, *design.lowPass);
+    toneFilters.setCoefficients(0, *design.lowPass2);
+    toneFilters.setCoefficients(1, *design.toneStack[0]);
+    toneFilters.setCoefficients(2, *design.toneStack[1]);
+
+    // Each frame starts a multiple of numLanes floats in, so it is as aligned as the first. The padded
+    // lanes stay silent.
+    auto numFrameFloats = numLanes * maximumFrames;
+    auto numSectionFloats = 2 * numLanes;
+
+    storage.assign(numFrameFloats + (1 + 3) * numSectionFloats + laneAlignment / sizeof(float), 0.f);
+    frames = juce::snapPointerToAlignment(storage.data(), laneAlignment);
+    lowPassState = frames + numFrameFloats;
+    toneFiltersState = lowPassState + numSectionFloats;
+
+    // The streams are the clipper's channels
+    auto& tier = QualitySettings::get(quality);
+
+    clipper.prepare({ design.sampleRate, (juce::uint32)maximumBlockSize, (juce::uint32)numStreams });
+    clipper.setType((ClipperType)settings.clipper_type);
+    clipper.setDrive(settings.drive);
+    clipper.setAntiderivativeAntialiasing(settings.clipper_adaa);
+    clipper.setNumStages(settings.gain_stages);
+    clipper.setStageDrive(settings.stage_drive);
+    clipper.setOversamplingOrder(tier.oversamplingOrder);
+    clipper.setUseApproximations(tier.useApproximations);
+    clipper.setDiodeNewtonIterations(tier.diodeNewtonIterations);
+
+    cabinets.clear();
+    cabinetLoaded = false;
+
+    for (int k = 0; k < numStreams; ++k)
+    {
+        auto* cabinet = cabinets.add(new CabinetConvolution());
+        cabinet->setMaximumLength(tier.cabinetSeconds);
+        cabinet->setNonRealtime(true);
+        cabinet->setLightMode(settings.light_cabinet);
+        cabinet->prepare({ design.sampleRate, (juce::uint32)maximumBlockSize, 1 });
+    }
+}
+
+void BatchEngine::reset() noexcept
+{
+    std::fill(storage.begin(), storage.end(), 0.f);
+    clipper.reset();
+
+    for (auto* cabinet : cabinets)
+        cabinet->reset();
+}
+
+void BatchEngine::loadCabinetResponse(const juce::AudioBuffer<float>& response, double responseSampleRate)
+{
+    jassert(cabinets.size() == numStreams);
+
+    for (auto* cabinet : cabinets)
+        cabinet->loadImpulseResponse(response, responseSampleRate);
+
+    cabinetLoaded = true;
+}
+
+void BatchEngine::process(const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    TRACE_SCOPE("Batch engine block");
+
+    jassert(kernels != nullptr && block.getNumChannels() == (size_t)numStreams);
+    jassert(block.getNumSamples() <= maximumFrames);
+
+    auto numSamples = block.getNumSamples();
+    auto streams = block;
+
+    // Input and LowPass, as processFused runs them
+    interleave(block, inputGain);
+    processLanes(*kernels, lowPass, frames, numSamples, numLanes, lowPassState, 1.f);
+    deinterleave(block);
+
+    clipper.process(juce::dsp::ProcessContextReplacing<float>(streams));
+
+    // ToneFilters and Volume, as processFusedCascade runs them
+    interleave(block, 1.f);
+    processLanes(*kernels, toneFilters, frames, numSamples, numLanes, toneFiltersState, volumeGain);
+    deinterleave(block);
+
+    for (int k = 0; k < numStreams; ++k)
+    {
+        auto stream = streams.getSingleChannelBlock((size_t)k);
+
+        if (cabinetLoaded)
+            cabinets.getUnchecked(k)->process(juce::dsp::ProcessContextReplacing<float>(stream));
+
+        kernels->multiply(stream.getChannelPointer(0), numSamples, outputGain);
+    }
+}
+
+void BatchEngine::interleave(const juce::dsp::AudioBlock<float>& block, float gain) noexcept
+{
+    auto numSamples = block.getNumSamples();
+
+    for (size_t k = 0; k < (size_t)numStreams; ++k)
+    {
+        auto* input = block.getChannelPointer(k);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            frames[i * numLanes + k] = input[i] * gain;
+    }
+}
+
+void BatchEngine::deinterleave(const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    auto numSamples = block.getNumSamples();
+
+    for (size_t k = 0; k < (size_t)numStreams; ++k)
+    {
+        auto* output = block.getChannelPointer(k);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = frames[i * numLanes + k];
+    }
+}
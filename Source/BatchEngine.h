@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    BatchEngine.h
+    Created: 26 Oct 2026 10:04:18am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspState.h"
+#include "Quality.h"
+#include "ClipperCascade.h"
+#include "CabinetConvolution.h"
+#include "FilterCascade.h"
+#include "SimdKernels.h"
+
+// The plugin's chain for many mono streams that share one set of settings, for reamping many DI
+// tracks through the same preset. The coefficients get designed once, by the processor that makes the
+// snapshot, and the streams run side by side in the lanes of a register: as many as the active
+// SimdKernels set has lanes (4, 8 or 16), the last register padded with silent lanes.
+//
+// The gains and the filters on either side of the clipper run that way, each lane with its own state.
+// The oversampled clipper runs the streams as the channels of one ClipperCascade, and every stream
+// gets its own cabinet. With the baseline kernels a stream comes out the same as through the plugin's
+// left chain with the same settings at the same rate, the "batch" benchmark checks that.
+//
+// Not realtime: for the offline CLI, or a host rendering in the background.
+class BatchEngine
+{
+public:
+    // Takes the kernel set that is active now, and keeps it until the next prepare
+    void prepare(const DspSnapshot& design, int numStreams, int maximumBlockSize, Quality quality = Quality::High);
+    void reset() noexcept;
+
+    // Message thread, after prepare. Without one the streams skip the cabinet.
+    void loadCabinetResponse(const juce::AudioBuffer<float>& response, double responseSampleRate);
+
+    // Channel k of the block is stream k, processed in place. No more than maximumBlockSize samples.
+    void process(const juce::dsp::AudioBlock<float>& block) noexcept;
+
+    int getNumStreams() const noexcept          { return numStreams; }
+    int getNumLanes() const noexcept            { return (int)numLanes; }
+    int getLatencyInSamples() const noexcept    { return juce::roundToInt(clipper.getLatencyInSamples()); }
+
+private:
+    void interleave(const juce::dsp::AudioBlock<float>& block, float gain) noexcept;
+    void deinterleave(const juce::dsp::AudioBlock<float>& block) noexcept;
+
+    const SimdKernels* kernels { nullptr };
+
+    int numStreams { 0 };
+    size_t numLanes { 0 }, maximumFrames { 0 };
+
+    float inputGain { 1 }, volumeGain { 1 }, outputGain { 1 };
+
+    // Only the designs, the lanes keep the state: the clipper's low pass, and LowPass2 and the tone
+    // stack's two sections. The high shelf stays bypassed, as it does in the plugin.
+    FilterCascade<1> lowPass;
+    FilterCascade<3> toneFilters;
+
+    // Frames of numLanes samples, then each filter's state, aligned for the widest register
+    std::vector<float> storage;
+    float* frames { nullptr };
+    float* lowPassState { nullptr };
+    float* toneFiltersState { nullptr };
+
+    ClipperCascade clipper;
+    juce::OwnedArray<CabinetConvolution> cabinets;
+    bool cabinetLoaded { false };
+
+    JUCE_LEAK_DETECTOR (BatchEngine)
+};
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    CabinetBlend.cpp
+    Created: 23 Oct 2026 10:17:05am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "CabinetBlend.h"
+#include "Trace.h"
+
+CabinetBlend::CabinetBlend(std::function<void()> callback)
+    : onBaked(std::move(callback))
+{
+    backgroundThread->addTimeSliceClient(this);
+}
+
+CabinetBlend::~CabinetBlend()
+{
+    // waits for a bake that is running
+    backgroundThread->removeTimeSliceClient(this);
+}
+
+void CabinetBlend::setMicResponse(int index, const juce::AudioBuffer<float>& response, double sampleRate)
+{
+    jassert(juce::isPositiveAndBelow(index, maxMics));
+
+    const juce::ScopedLock sl(micLock);
+
+    auto& mic = mics[(size_t)index];
+    mic.response.setSize(1, response.getNumSamples());
+    mic.response.copyFrom(0, 0, response, 0, 0, response.getNumSamples());
+    mic.sampleRate = sampleRate;
+}
+
+double CabinetBlend::getSampleRate() const
+{
+    const juce::ScopedLock sl(micLock);
+    return mics[0].sampleRate;
+}
+
+juce::AudioBuffer<float> CabinetBlend::bake(const Blend& blend) const
+{
+    TRACE_SCOPE("Cabinet mic blend bake");
+
+    const juce::ScopedLock sl(micLock);
+
+    auto sampleRate = mics[0].sampleRate;
+
+    if (sampleRate <= 0)
+        return {};
+
+    // Each mic at the rate of the mix, and where it starts in it. Offsets are rounded to whole samples.
+    std::array<std::vector<float>, maxMics> resampled;
+    std::array<int, maxMics> offsets {};
+    int length = 0;
+
+    for (size_t i = 0; i < (size_t)maxMics; ++i)
+    {
+        auto& mic = mics[i];
+
+        if (mic.response.getNumSamples() == 0 || mic.sampleRate <= 0)
+            continue;
+
+        auto ratio = mic.sampleRate / sampleRate;
+        auto micLength = (int)std::ceil(mic.response.getNumSamples() / ratio);
+
+        std::vector<float> source((size_t)mic.response.getNumSamples() + 8, 0.f);
+        std::copy(mic.response.getReadPointer(0), mic.response.getReadPointer(0) + mic.response.getNumSamples(), source.begin());
+
+        resampled[i].resize((size_t)micLength);
+
+        if (ratio == 1.0)
+            std::copy(source.begin(), source.begin() + micLength, resampled[i].begin());
+        else
+            juce::LagrangeInterpolator().process(ratio, source.data(), resampled[i].data(), micLength);
+
+        auto energy = std::accumulate(resampled[i].begin(), resampled[i].end(), 0.f, [] (float sum, float s) { return sum + s * s; });
+
+        if (energy > 0)
+            juce::FloatVectorOperations::multiply(resampled[i].data(), 0.125f / std::sqrt(energy), micLength);
+
+        offsets[i] = juce::roundToInt(juce::jmax(0.f, blend[i].offsetMilliseconds) * sampleRate / 1000.0);
+        length = juce::jmax(length, offsets[i] + micLength);
+    }
+
+    juce::AudioBuffer<float> mix(1, juce::jmax(1, length));
+    mix.clear();
+
+    float loudest = 0;
+
+    for (size_t i = 0; i < (size_t)maxMics; ++i)
+    {
+        auto gain = juce::Decibels::decibelsToGain(blend[i].levelDecibels, silenceDecibels);
+
+        if (gain == 0 || resampled[i].empty())
+            continue;
+
+        mix.addFrom(0, offsets[i], resampled[i].data(), (int)resampled[i].size(), blend[i].inverted ? -gain : gain);
+        loudest = juce::jmax(loudest, gain);
+    }
+
+    // Nothing left at silenceDecibels below the loudest mic counts as silence. The cabinet keeps the
+    // response it has rather than muting the plugin.
+    auto* data = mix.getReadPointer(0);
+    auto energy = std::accumulate(data, data + mix.getNumSamples(), 0.f, [] (float sum, float s) { return sum + s * s; });
+    auto silence = 0.125f * loudest * juce::Decibels::decibelsToGain(silenceDecibels);
+
+    if (energy <= silence * silence)
+        return {};
+
+    return mix;
+}
+
+void CabinetBlend::requestBake(const Blend& blend)
+{
+    const juce::ScopedLock sl(bakeLock);
+
+    pendingBlend = blend;
+    bakePending = true;
+    bakeReady = false;
+}
+
+bool CabinetBlend::takeBaked(juce::AudioBuffer<float>& response)
+{
+    const juce::ScopedLock sl(bakeLock);
+
+    if (! bakeReady)
+        return false;
+
+    std::swap(response, baked);
+    bakeReady = false;
+    return true;
+}
+
+int CabinetBlend::useTimeSlice()
+{
+    Blend blend;
+
+    {
+        const juce::ScopedLock sl(bakeLock);
+
+        if (! bakePending)
+            return 50;
+
+        blend = pendingBlend;
+        bakePending = false;
+    }
+
+    auto mix = bake(blend);
+
+    {
+        const juce::ScopedLock sl(bakeLock);
+
+        // a newer request came in while this one was mixing, it replaces it
+        if (bakePending)
+            return 0;
+
+        std::swap(baked, mix);
+        bakeReady = true;
+    }
+
+    onBaked();
+    return 50;
+}
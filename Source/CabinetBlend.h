@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    CabinetBlend.h
+    Created: 23 Oct 2026 10:17:05am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BackgroundThread.h"
+
+// Mixes the responses of several mics on the cabinet into the one response the Cabinet position
+// convolves, so a blend costs the same as a single mic. Each mic has a level, a polarity and an
+// offset that delays it to line it up with the others.
+//
+// Mixes are baked on the shared background thread. The owner gets called back from there when one
+// is ready and collects it with takeBaked() on the message thread.
+class CabinetBlend : private juce::TimeSliceClient
+{
+public:
+    static constexpr int maxMics = 2;
+
+    // Mics at this level or below are left out of the mix
+    static constexpr float silenceDecibels = -60.f;
+
+    struct Mic
+    {
+        float levelDecibels { 0 };
+        bool inverted { false };
+        float offsetMilliseconds { 0 };
+
+        bool operator== (const Mic& other) const
+        {
+            return std::tie(levelDecibels, inverted, offsetMilliseconds)
+                == std::tie(other.levelDecibels, other.inverted, other.offsetMilliseconds);
+        }
+
+        bool operator!= (const Mic& other) const { return ! (*this == other); }
+    };
+
+    using Blend = std::array<Mic, maxMics>;
+
+    explicit CabinetBlend(std::function<void()> onBaked);
+    ~CabinetBlend() override;
+
+    // Message thread. The first mic's rate is the rate of the mix.
+    void setMicResponse(int index, const juce::AudioBuffer<float>& response, double sampleRate);
+    double getSampleRate() const;
+
+    // Mixes on the calling thread. Each mic is normalised the way juce::dsp::Convolution normalises a
+    // response before its level applies, so the levels set the mix's loudness as well as the balance.
+    // An empty buffer when the mics are all out of the mix or cancel each other out.
+    juce::AudioBuffer<float> bake(const Blend& blend) const;
+
+    // Message thread. Only the latest request gets baked, takeBaked() returns false until it's done.
+    void requestBake(const Blend& blend);
+    bool takeBaked(juce::AudioBuffer<float>& response);
+
+private:
+    struct MicResponse
+    {
+        juce::AudioBuffer<float> response;
+        double sampleRate { 0 };
+    };
+
+    int useTimeSlice() override;
+
+    std::function<void()> onBaked;
+
+    std::array<MicResponse, maxMics> mics;
+    juce::CriticalSection micLock;
+
+    Blend pendingBlend;
+    bool bakePending { false }, bakeReady { false };
+    juce::AudioBuffer<float> baked;
+    juce::CriticalSection bakeLock;
+
+    juce::SharedResourcePointer<BackgroundThread> backgroundThread;
+
+    JUCE_DECLARE_NON_COPYABLE (CabinetBlend)
+};
@@ -0,0 +1,724 @@
+/*
+  ==============================================================================
+
+    CabinetConvolution.cpp
+    Created: 20 Oct 2026 10:02:36am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "CabinetConvolution.h"
+#include "Trace.h"
+#include "SimdKernels.h"
+
+// Uniformly partitioned overlap-save convolution. The tail runs it a partition at a time,
+// processPartition() returns one partition of output delayed by nothing beyond the partition itself.
+// The head runs processSamples() instead, which has no latency: the partition still filling up gets
+// transformed with the rest of it zero, on every call.
+class CabinetConvolution::PartitionedConvolver
+{
+public:
+    PartitionedConvolver(const float* impulseResponse, int length, int newPartitionSize)
+        : partitionSize(newPartitionSize),
+          numBins(newPartitionSize + 1),
+          numPartitions((length + newPartitionSize - 1) / newPartitionSize),
+          fft(juce::roundToInt(std::log2(2 * newPartitionSize)))
+    {
+        jassert(juce::isPowerOfTwo(partitionSize));
+
+        filterSpectra.resize((size_t)(numPartitions * numBins * 2));
+        delayLine.resize(filterSpectra.size());
+        accumulator.resize((size_t)numBins * 2);
+        history.resize(accumulator.size());
+        window.resize((size_t)partitionSize * 2);
+        fftBuffer.resize((size_t)partitionSize * 4);
+
+        for (int k = 0; k < numPartitions; ++k)
+        {
+            auto offset = k * partitionSize;
+            auto count = juce::jmin(partitionSize, length - offset);
+
+            std::fill(fftBuffer.begin(), fftBuffer.end(), 0.f);
+            std::copy(impulseResponse + offset, impulseResponse + offset + count, fftBuffer.begin());
+            fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+            std::copy(fftBuffer.begin(), fftBuffer.begin() + numBins * 2, filterSpectra.begin() + k * numBins * 2);
+        }
+    }
+
+    int getPartitionSize() const noexcept   { return partitionSize; }
+
+    // Takes over the input the other one has seen, as far back as this one reaches
+    void copyHistoryFrom(const PartitionedConvolver& other) noexcept
+    {
+        jassert(other.partitionSize == partitionSize);
+
+        std::copy(other.window.begin(), other.window.end(), window.begin());
+        std::fill(delayLine.begin(), delayLine.end(), 0.f);
+        fill = other.fill;
+
+        auto spectrumSize = numBins * 2;
+
+        // newest first, into the slots just behind position 0
+        for (int k = 0; k < juce::jmin(numPartitions, other.numPartitions); ++k)
+        {
+            auto from = (other.delayLinePosition - 1 - k + other.numPartitions) % other.numPartitions;
+            auto to = numPartitions - 1 - k;
+
+            std::copy(other.delayLine.begin() + from * spectrumSize, other.delayLine.begin() + (from + 1) * spectrumSize,
+                      delayLine.begin() + to * spectrumSize);
+        }
+
+        delayLinePosition = 0;
+
+        // what the earlier partitions add to the one filling up, through this response
+        if (fill > 0)
+            accumulateHistory();
+    }
+
+    void reset() noexcept
+    {
+        std::fill(delayLine.begin(), delayLine.end(), 0.f);
+        std::fill(window.begin(), window.end(), 0.f);
+        delayLinePosition = 0;
+        fill = 0;
+    }
+
+    void processSamples(const float* input, float* output, int numSamples) noexcept
+    {
+        auto spectrumSize = numBins * 2;
+        auto multiplyAccumulate = SimdKernels::get().complexMultiplyAccumulate;
+
+        while (numSamples > 0)
+        {
+            // A new partition: slide the window along, the earlier partitions' part of it stays the same
+            if (fill == 0)
+            {
+                std::copy(window.begin() + partitionSize, window.end(), window.begin());
+                std::fill(window.begin() + partitionSize, window.end(), 0.f);
+                accumulateHistory();
+            }
+
+            auto start = fill;
+            auto count = juce::jmin(numSamples, partitionSize - fill);
+            std::copy(input, input + count, window.begin() + partitionSize + start);
+            fill += count;
+
+            std::copy(window.begin(), window.end(), fftBuffer.begin());
+            std::fill(fftBuffer.begin() + partitionSize * 2, fftBuffer.end(), 0.f);
+            fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+            std::copy(history.begin(), history.end(), accumulator.begin());
+            multiplyAccumulate(accumulator.data(), fftBuffer.data(), filterSpectra.data(), (size_t)numBins);
+
+            // a complete partition joins the history
+            if (fill == partitionSize)
+            {
+                std::copy(fftBuffer.begin(), fftBuffer.begin() + spectrumSize, delayLine.begin() + delayLinePosition * spectrumSize);
+                delayLinePosition = (delayLinePosition + 1) % numPartitions;
+                fill = 0;
+            }
+
+            std::copy(accumulator.begin(), accumulator.end(), fftBuffer.begin());
+            std::fill(fftBuffer.begin() + spectrumSize, fftBuffer.end(), 0.f);
+            fft.performRealOnlyInverseTransform(fftBuffer.data());
+
+            std::copy(fftBuffer.begin() + partitionSize + start, fftBuffer.begin() + partitionSize + start + count, output);
+
+            input += count;
+            output += count;
+            numSamples -= count;
+        }
+    }
+
+    void processPartition(const float* input, float* output) noexcept
+    {
+        // slide the two partition window along and transform it
+        std::copy(window.begin() + partitionSize, window.end(), window.begin());
+        std::copy(input, input + partitionSize, window.begin() + partitionSize);
+
+        std::copy(window.begin(), window.end(), fftBuffer.begin());
+        std::fill(fftBuffer.begin() + partitionSize * 2, fftBuffer.end(), 0.f);
+        fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+        auto spectrumSize = numBins * 2;
+        std::copy(fftBuffer.begin(), fftBuffer.begin() + spectrumSize, delayLine.begin() + delayLinePosition * spectrumSize);
+
+        // the newest input spectrum meets the first filter partition, the oldest one the last
+        std::fill(accumulator.begin(), accumulator.end(), 0.f);
+        auto multiplyAccumulate = SimdKernels::get().complexMultiplyAccumulate;
+
+        for (int k = 0; k < numPartitions; ++k)
+        {
+            auto slot = (delayLinePosition - k + numPartitions) % numPartitions;
+            multiplyAccumulate(accumulator.data(), delayLine.data() + slot * spectrumSize,
+                               filterSpectra.data() + k * spectrumSize, (size_t)numBins);
+        }
+
+        std::copy(accumulator.begin(), accumulator.end(), fftBuffer.begin());
+        std::fill(fftBuffer.begin() + spectrumSize, fftBuffer.end(), 0.f);
+        fft.performRealOnlyInverseTransform(fftBuffer.data());
+
+        // the first half is wrapped around, the second half is the output
+        std::copy(fftBuffer.begin() + partitionSize, fftBuffer.begin() + partitionSize * 2, output);
+
+        delayLinePosition = (delayLinePosition + 1) % numPartitions;
+    }
+
+private:
+    // The partitions before the current one, each through the part of the response that reaches it
+    void accumulateHistory() noexcept
+    {
+        auto spectrumSize = numBins * 2;
+        auto multiplyAccumulate = SimdKernels::get().complexMultiplyAccumulate;
+
+        std::fill(history.begin(), history.end(), 0.f);
+
+        for (int k = 1; k < numPartitions; ++k)
+        {
+            auto slot = (delayLinePosition - k + numPartitions) % numPartitions;
+            multiplyAccumulate(history.data(), delayLine.data() + slot * spectrumSize,
+                               filterSpectra.data() + k * spectrumSize, (size_t)numBins);
+        }
+    }
+
+    int partitionSize, numBins, numPartitions;
+    juce::dsp::FFT fft;
+
+    std::vector<float> filterSpectra, delayLine, accumulator, history, window, fftBuffer;
+    int delayLinePosition { 0 }, fill { 0 };
+};
+
+//==============================================================================
+void CabinetConvolution::TailJob::run() noexcept
+{
+    TRACE_SCOPE("Cabinet tail partition");
+
+    convolver.load()->processPartition(input, output);
+
+    if (auto* previous = fading.load())
+    {
+        auto partitionSize = previous->getPartitionSize();
+        previous->processPartition(input, scratch);
+
+        for (int i = 0; i < partitionSize; ++i)
+            output[i] = scratch[i] + (output[i] - scratch[i]) * ((float)i + 0.5f) / (float)partitionSize;
+    }
+}
+
+CabinetConvolution::Response::~Response()
+{
+    // A worker may still be busy with the last partition the audio thread handed it
+    if (job != nullptr)
+        while ((job->convolver.load() == tail.get() || job->fading.load() == tail.get()) && ! job->isIdle())
+            juce::Thread::sleep(1);
+}
+
+//==============================================================================
+CabinetConvolution::CabinetConvolution()
+{
+    backgroundThread->addTimeSliceClient(this);
+}
+
+CabinetConvolution::~CabinetConvolution()
+{
+    // waits for a fit that is running
+    backgroundThread->removeTimeSliceClient(this);
+
+    job.finish();
+    job.waitUntilReleased();
+    releaseResponses();
+}
+
+void CabinetConvolution::loadImpulseResponse(const juce::AudioBuffer<float>& newImpulseResponse, double newSampleRate)
+{
+    if (newImpulseResponse.getNumSamples() == 0)
+        return;
+
+    impulseResponse.makeCopyOf(newImpulseResponse);
+    impulseResponseSampleRate = newSampleRate;
+
+    rebuild();
+}
+
+void CabinetConvolution::setThreadedTail(bool shouldUseWorkers)
+{
+    if (threadedTail.exchange(shouldUseWorkers) != shouldUseWorkers)
+        rebuild();
+}
+
+void CabinetConvolution::setMaximumLength(double seconds)
+{
+    if (seconds != maximumSeconds)
+    {
+        maximumSeconds = seconds;
+        rebuild();
+    }
+}
+
+void CabinetConvolution::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+
+    // Two blocks per partition leave the workers at least one block of slack. The head transforms
+    // its partition on every call, so that one is kept about a block long.
+    partitionSize = juce::jmax(256, juce::nextPowerOfTwo((int)spec.maximumBlockSize * 2));
+    headPartitionSize = juce::jmax(64, juce::nextPowerOfTwo((int)spec.maximumBlockSize));
+
+    dry.assign(spec.maximumBlockSize, 0.f);
+    headScratch.assign(spec.maximumBlockSize, 0.f);
+    pendingInput.assign((size_t)partitionSize, 0.f);
+    jobInput.assign((size_t)partitionSize, 0.f);
+
+    for (auto& o : tailOutputs)
+        o.assign((size_t)partitionSize, 0.f);
+
+    fadeScratch.assign((size_t)partitionSize, 0.f);
+    job.scratch = fadeScratch.data();
+
+    lightOutput.assign(spec.maximumBlockSize, 0.f);
+    lightMix.reset(sampleRate, 0.02);
+
+    // The fit in the cascades is for the previous rate. The convolution runs until the design gets
+    // checked against this rate again, or a fit for it arrives.
+    lightReady = false;
+    lightGeneration = 0;
+    lightMix.setCurrentAndTargetValue(0.f);
+
+    for (auto& cascade : lightCascades)
+        for (size_t n = 0; n < 4; ++n)
+            cascade.setBypassed(n, true);
+
+    rebuild();
+    reset();
+}
+
+void CabinetConvolution::reset() noexcept
+{
+    resetConvolution();
+
+    for (auto& cascade : lightCascades)
+        cascade.reset();
+
+    lightMix.setCurrentAndTargetValue(lightMix.getTargetValue());
+}
+
+void CabinetConvolution::copyStateFrom(CabinetConvolution& other) noexcept
+{
+    // the partition other has in flight is part of its state
+    other.job.finish();
+
+    // This one's own latest response, without a fade, then the other's history through it
+    resetConvolution();
+
+    auto* handle = responsePublisher.beginRead();
+
+    if (handle != nullptr)
+        switchResponse(*handle->response, handle->generation);
+
+    responsePublisher.endRead();
+
+    if (headResponse != nullptr && other.headResponse != nullptr)
+        headResponse->head->copyHistoryFrom(*other.headResponse->head);
+
+    auto* tail = activeResponse != nullptr ? activeResponse->tail.get() : nullptr;
+    auto* otherTail = other.activeResponse != nullptr ? other.activeResponse->tail.get() : nullptr;
+
+    if (tail != nullptr && otherTail != nullptr && tail->getPartitionSize() == otherTail->getPartitionSize())
+    {
+        tail->copyHistoryFrom(*otherTail);
+
+        // The output partitions the other has, the next one done, and how far into the current one it is
+        for (size_t i = 0; i < tailOutputs.size(); ++i)
+            std::copy(other.tailOutputs[i].begin(), other.tailOutputs[i].end(), tailOutputs[i].begin());
+
+        std::copy(other.pendingInput.begin(), other.pendingInput.end(), pendingInput.begin());
+        inputFill = other.inputFill;
+        outputIndex = other.outputIndex;
+        jobPending = other.jobPending;
+        job.outputIndex = other.job.outputIndex;
+    }
+
+    lightCascades = other.lightCascades;
+    lightReady = other.lightReady;
+    lightMix = other.lightMix;
+}
+
+void CabinetConvolution::resetConvolution() noexcept
+{
+    job.finish();
+    jobPending = false;
+    inputFill = 0;
+    outputIndex = -1;
+    releaseResponses();
+
+    // the audio thread clears the response's own state when it picks it up again
+    responseGeneration = 0;
+}
+
+void CabinetConvolution::letGo(const Response*& response) noexcept
+{
+    auto* released = response;
+    response = nullptr;
+
+    if (released != nullptr && released != activeResponse && released != fadingTail && released != fadeSubmitted
+         && released != headResponse && released != fadingHead && released != pendingHead)
+        released->held.store(false, std::memory_order_release);
+}
+
+void CabinetConvolution::releaseResponses() noexcept
+{
+    for (auto** response : { &activeResponse, &fadingTail, &fadeSubmitted, &headResponse, &fadingHead, &pendingHead })
+    {
+        if (*response != nullptr)
+            (*response)->held.store(false, std::memory_order_release);
+
+        *response = nullptr;
+    }
+}
+
+void CabinetConvolution::rebuild()
+{
+    TRACE_SCOPE("Cabinet response rebuild");
+
+    if (sampleRate <= 0 || impulseResponse.getNumSamples() == 0)
+        return;
+
+    // Resample to the processing rate
+    auto ratio = impulseResponseSampleRate / sampleRate;
+    auto length = (int)std::ceil(impulseResponse.getNumSamples() / ratio);
+
+    std::vector<float> source((size_t)impulseResponse.getNumSamples() + 8, 0.f);
+    std::copy(impulseResponse.getReadPointer(0), impulseResponse.getReadPointer(0) + impulseResponse.getNumSamples(), source.begin());
+
+    std::vector<float> resampled((size_t)length);
+
+    if (ratio == 1.0)
+        std::copy(source.begin(), source.begin() + length, resampled.begin());
+    else
+        juce::LagrangeInterpolator().process(ratio, source.data(), resampled.data(), length);
+
+    // Interpolating spreads the energy over 1 / ratio times the samples, CabinetBlend normalised it at its own rate
+    if (ratio != 1.0)
+        juce::FloatVectorOperations::multiply(resampled.data(), (float)std::sqrt(ratio), length);
+
+    // Truncated after the level is set, so it stays the same
+    if (maximumSeconds > 0 && length > (int)(maximumSeconds * sampleRate))
+    {
+        length = (int)(maximumSeconds * sampleRate);
+        auto fadeLength = juce::jmin(length, (int)(0.005 * sampleRate));
+
+        for (int i = 0; i < fadeLength; ++i)
+            resampled[(size_t)(length - fadeLength + i)] *= 0.5f * (1.f + std::cos(juce::MathConstants<float>::pi * (float)i / (float)fadeLength));
+    }
+
+    {
+        const juce::ScopedLock sl(responseLock);
+        fitResponse.assign(resampled.begin(), resampled.begin() + length);
+        fitSampleRate = sampleRate;
+        fitPending = true;
+    }
+
+    auto headLength = threadedTail.load() ? juce::jmin(length, partitionSize * 2) : length;
+
+    auto response = std::make_unique<Response>();
+    response->job = &job;
+    response->head = std::make_unique<PartitionedConvolver>(resampled.data(), headLength, headPartitionSize);
+
+    if (length > headLength)
+        response->tail = std::make_unique<PartitionedConvolver>(resampled.data() + headLength, length - headLength, partitionSize);
+
+    Response* added;
+
+    {
+        const juce::ScopedLock sl(responsesLock);
+        added = responses.add(response.release());
+    }
+
+    responsePublisher.publish(std::make_unique<ResponseHandle>(*added));
+}
+
+void CabinetConvolution::freeReleasedResponses()
+{
+    juce::OwnedArray<Response> released;
+
+    {
+        const juce::ScopedLock sl(responsesLock);
+
+        // A handle is only gone once the reader can't be in the middle of picking its response up
+        for (int i = responses.size(); --i >= 0;)
+            if (! responses[i]->published.load(std::memory_order_acquire) && ! responses[i]->held.load(std::memory_order_acquire))
+                released.add(responses.removeAndReturn(i));
+    }
+
+    // a worker may still be finishing one of them, which they wait for
+}
+
+void CabinetConvolution::switchResponse(const Response& response, juce::uint64 generation) noexcept
+{
+    // the job may still be on the previous response
+    job.finish();
+
+    // a fade that hasn't finished yet is cut short
+    letGo(fadingTail);
+    letGo(fadeSubmitted);
+    letGo(fadingHead);
+    job.fading.store(nullptr);
+
+    auto* previous = activeResponse;
+
+    auto seamless = responseGeneration != 0 && previous != nullptr && previous->tail != nullptr && response.tail != nullptr
+                    && previous->tail->getPartitionSize() == response.tail->getPartitionSize();
+
+    if (seamless)
+    {
+        response.tail->copyHistoryFrom(*previous->tail);
+        fadingTail = previous;
+    }
+    else
+    {
+        jobPending = false;
+        inputFill = 0;
+        outputIndex = -1;
+
+        if (response.tail != nullptr)
+            response.tail->reset();
+    }
+
+    // The old head keeps running until the partition the old tail fades out in, two partitions on,
+    // or the next one when there's no tail to wait for. Then the two heads fade with the same ramp.
+    letGo(pendingHead);
+
+    if (headResponse == nullptr)
+    {
+        response.head->reset();
+        headResponse = &response;
+    }
+    else
+    {
+        pendingHead = &response;
+        headFadeDelay = seamless ? 2 : 1;
+    }
+
+    response.held.store(true, std::memory_order_release);
+    activeResponse = &response;
+    responseGeneration = generation;
+    letGo(previous);
+}
+
+void CabinetConvolution::processConvolution(const float* input, float* output, size_t numSamples) noexcept
+{
+    auto* handle = responsePublisher.beginRead();
+
+    if (handle != nullptr && handle->generation != responseGeneration)
+        switchResponse(*handle->response, handle->generation);
+
+    // the responses it runs are held from here on
+    responsePublisher.endRead();
+
+    if (headResponse == nullptr)
+    {
+        // nothing loaded yet, it passes through
+        std::copy(input, input + numSamples, output);
+        return;
+    }
+
+    auto* tail = activeResponse->tail.get();
+
+    // Input and output go through partitions in step. The tail of the output in partition n
+    // comes from the input of partition n - 2, which went to the workers at the end of n - 1.
+    size_t position = 0;
+
+    while (position < numSamples)
+    {
+        auto count = juce::jmin(numSamples - position, (size_t)(partitionSize - inputFill));
+
+        processHead(input + position, output + position, count);
+
+        std::copy(input + position, input + position + count, pendingInput.begin() + inputFill);
+
+        if (outputIndex >= 0)
+            juce::FloatVectorOperations::add(output + position, tailOutputs[(size_t)outputIndex].data() + inputFill, (int)count);
+
+        inputFill += (int)count;
+        position += count;
+
+        if (inputFill < partitionSize)
+            continue;
+
+        inputFill = 0;
+
+        if (tail != nullptr)
+        {
+            // the partition in flight is the one the next output partition needs
+            if (jobPending)
+            {
+                job.finish();
+                outputIndex = job.outputIndex;
+            }
+
+            letGo(fadeSubmitted);
+
+            job.fading.store(fadingTail != nullptr ? fadingTail->tail.get() : nullptr);
+            std::swap(fadingTail, fadeSubmitted);
+
+            std::swap(pendingInput, jobInput);
+
+            job.convolver.store(tail);
+            job.input = jobInput.data();
+            job.outputIndex = outputIndex == 0 ? 1 : 0;
+            job.output = tailOutputs[(size_t)job.outputIndex].data();
+
+            if (nonRealtime || ! workerPool->submit(job))
+                job.runNow();
+
+            jobPending = true;
+        }
+
+        // A head fade lasts a partition
+        letGo(fadingHead);
+
+        if (pendingHead != nullptr && --headFadeDelay == 0)
+        {
+            pendingHead->head->copyHistoryFrom(*headResponse->head);
+            fadingHead = headResponse;
+            headResponse = pendingHead;
+            pendingHead = nullptr;
+        }
+    }
+}
+
+void CabinetConvolution::processHead(const float* input, float* output, size_t numSamples) noexcept
+{
+    headResponse->head->processSamples(input, output, (int)numSamples);
+
+    if (fadingHead == nullptr)
+        return;
+
+    // the ramp the job fades the old tail out with, over the same partition
+    fadingHead->head->processSamples(input, headScratch.data(), (int)numSamples);
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto ramp = ((float)inputFill + (float)i + 0.5f) / (float)partitionSize;
+        output[i] = headScratch[i] + (output[i] - headScratch[i]) * ramp;
+    }
+}
+
+int CabinetConvolution::useTimeSlice()
+{
+    freeReleasedResponses();
+
+    // Nothing gets fitted until the light cabinet is asked for
+    if (lightMode.load())
+        fitPendingResponse();
+
+    return 100;
+}
+
+void CabinetConvolution::fitPendingResponse()
+{
+    const juce::ScopedLock fl(fitLock);
+
+    std::vector<float> response;
+    double responseSampleRate;
+
+    {
+        const juce::ScopedLock sl(responseLock);
+
+        if (! fitPending)
+            return;
+
+        std::swap(response, fitResponse);
+        responseSampleRate = fitSampleRate;
+        fitPending = false;
+    }
+
+    auto design = std::make_unique<LightDesign>();
+    design->sections = CabinetFit::fit(response.data(), (int)response.size(), responseSampleRate).sections;
+    design->sampleRate = responseSampleRate;
+
+    lightPublisher.publish(std::move(design));
+}
+
+bool CabinetConvolution::updateLightDesign() noexcept
+{
+    // Offline renders shouldn't depend on when the background thread gets to it
+    if (nonRealtime)
+        fitPendingResponse();
+
+    auto* design = lightPublisher.beginRead();
+
+    if (design != nullptr && design->generation != lightGeneration)
+    {
+        lightGeneration = design->generation;
+
+        // one made before the last prepare is for the wrong rate
+        lightReady = design->sampleRate == sampleRate && ! design->sections.isEmpty();
+
+        if (lightReady)
+        {
+            for (int n = 0; n < CabinetFit::maxSections; ++n)
+            {
+                auto& cascade = lightCascades[(size_t)n / 4];
+                auto index = (size_t)n % 4;
+
+                cascade.setBypassed(index, n >= design->sections.size());
+
+                if (n < design->sections.size())
+                    cascade.setCoefficients(index, *design->sections.getObjectPointerUnchecked(n));
+            }
+        }
+    }
+
+    lightPublisher.endRead();
+    return lightReady;
+}
+
+CabinetConvolution::Paths CabinetConvolution::choosePaths() noexcept
+{
+    auto light = lightMode.load() && updateLightDesign();
+    auto target = light ? 1.f : 0.f;
+
+    if (target != lightMix.getTargetValue())
+    {
+        // The path coming in has been idle since it last ran, its state is stale
+        if (! lightMix.isSmoothing())
+        {
+            if (light)
+                for (auto& cascade : lightCascades)
+                    cascade.reset();
+            else
+                resetConvolution();
+        }
+
+        lightMix.setTargetValue(target);
+    }
+
+    // both run while the mix moves
+    auto fading = lightMix.isSmoothing();
+    return { fading || ! light, fading || light };
+}
+
+void CabinetConvolution::processLight(const float* input, float* output, size_t numSamples, bool crossfade) noexcept
+{
+    jassert(numSamples <= lightOutput.size());
+
+    // The fitted sections four at a time, as the tone filters run
+    auto* light = crossfade ? lightOutput.data() : output;
+    std::copy(input, input + numSamples, light);
+
+    auto& kernels = SimdKernels::get();
+    SimdKernels::Levels unused;
+
+    for (auto& cascade : lightCascades)
+    {
+        FilterCascade<4>::Kernel kernel(cascade);
+        kernels.cascade(light, numSamples, kernel.b, kernel.a, kernel.s, 1.f, unused);
+        kernel.finish();
+    }
+
+    if (crossfade)
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] += (light[i] - output[i]) * lightMix.getNextValue();
+}
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    CabinetConvolution.h
+    Created: 20 Oct 2026 10:02:36am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspState.h"
+#include "WorkerPool.h"
+#include "FilterCascade.h"
+#include "CabinetFit.h"
+
+// The Cabinet position of the chain, for one channel.
+//
+// By default the whole impulse response runs as the head, a zero latency partitioned convolution on
+// the audio thread. With the threaded tail, the head only gets the first two tail partitions of the
+// response, and the rest is a uniformly partitioned FFT convolution computed on the shared
+// WorkerPool. Each tail partition is handed off as soon as its input is complete and is only needed
+// one partition later, so a worker has at least a block's worth of time for it. When it isn't done
+// by then, the audio thread runs it itself. Offline rendering always runs it in line.
+//
+// The head and the tail of a response are built and published together. A new one doesn't restart
+// either: each takes over the input history of the old one, and the old response fades out over one
+// partition, the head with the same ramp and in the same partition as the tail.
+//
+// The light cabinet runs a cascade of biquads fitted to the response's magnitude instead, see
+// CabinetFit, at a fraction of the cost. The fit runs on the shared background thread once the light
+// cabinet is asked for, and again for every new response or rate.
+class CabinetConvolution : private juce::TimeSliceClient
+{
+public:
+    CabinetConvolution();
+    ~CabinetConvolution() override;
+
+    // Message thread. The response gets resampled to the processing rate, keeping its energy, so the
+    // level it comes with is the level it plays at. An empty response keeps the one loaded before.
+    void loadImpulseResponse(const juce::AudioBuffer<float>& impulseResponse, double impulseResponseSampleRate);
+
+    // Message thread, this reallocates
+    void setThreadedTail(bool shouldUseWorkers);
+    bool isThreadedTail() const noexcept                { return threadedTail.load(); }
+
+    // Message thread. Cuts the response short, with a short fade. 0 keeps all of it.
+    void setMaximumLength(double seconds);
+
+    void setNonRealtime(bool isNonRealtime) noexcept    { nonRealtime = isNonRealtime; }
+
+    // Audio thread. Switches between the convolution and the light cabinet with a 20 ms crossfade, the
+    // path coming in starts from silence. The convolution keeps running until the fit of the current
+    // response is ready, offline the fit runs in line instead.
+    void setLightMode(bool shouldBeLight) noexcept      { lightMode.store(shouldBeLight); }
+    bool isLightMode() const noexcept                   { return lightMode.load(); }
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset() noexcept;
+
+    // Audio thread, with other not running. Picks up where other is, prepared alike and loaded with the
+    // same responses: its input history, the tail partitions it has computed and the light cascades.
+    void copyStateFrom(CabinetConvolution& other) noexcept;
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto&& inputBlock = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+        auto numSamples = inputBlock.getNumSamples();
+
+        jassert(inputBlock.getNumChannels() == 1);
+        jassert(numSamples <= dry.size());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+
+            return;
+        }
+
+        std::copy(inputBlock.getChannelPointer(0), inputBlock.getChannelPointer(0) + numSamples, dry.begin());
+
+        auto paths = choosePaths();
+
+        if (paths.convolution)
+            processConvolution(dry.data(), outputBlock.getChannelPointer(0), numSamples);
+
+        if (paths.light)
+            processLight(dry.data(), outputBlock.getChannelPointer(0), numSamples, paths.convolution);
+    }
+
+private:
+    class PartitionedConvolver;
+
+    struct TailJob : public WorkerPool::Job
+    {
+        std::atomic<PartitionedConvolver*> convolver { nullptr };
+        const float* input { nullptr };
+        float* output { nullptr };
+        int outputIndex { 0 };
+
+        // the previous response, faded out over this partition
+        std::atomic<PartitionedConvolver*> fading { nullptr };
+        float* scratch { nullptr };
+
+        void run() noexcept override;
+    };
+
+    // A response's head and tail. Owned by responses, as the audio thread can keep running one after
+    // it got replaced. It is freed once it is neither published nor held.
+    struct Response
+    {
+        std::unique_ptr<PartitionedConvolver> head, tail;
+        TailJob* job { nullptr };
+
+        // Cleared when the handle publishing it is gone, and when the audio thread lets go of it
+        std::atomic<bool> published { true };
+        mutable std::atomic<bool> held { false };
+
+        ~Response();
+    };
+
+    // What responsePublisher hands over, the audio thread only reaches a response through one
+    struct ResponseHandle
+    {
+        explicit ResponseHandle(Response& r) noexcept : response(&r) {}
+        ~ResponseHandle()                               { response->published.store(false, std::memory_order_release); }
+
+        const Response* response;
+        juce::uint64 generation { 0 };
+    };
+
+    // A fit for the light cabinet, at the rate it was made for
+    struct LightDesign
+    {
+        juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> sections;
+        double sampleRate { 0 };
+        juce::uint64 generation { 0 };
+    };
+
+    struct Paths
+    {
+        bool convolution, light;
+    };
+
+    void rebuild();
+    void switchResponse(const Response& response, juce::uint64 generation) noexcept;
+    void letGo(const Response*& response) noexcept;
+    void releaseResponses() noexcept;
+    void freeReleasedResponses();
+    void resetConvolution() noexcept;
+    void processConvolution(const float* input, float* output, size_t numSamples) noexcept;
+    void processHead(const float* input, float* output, size_t numSamples) noexcept;
+
+    int useTimeSlice() override;
+    void fitPendingResponse();
+    bool updateLightDesign() noexcept;
+    Paths choosePaths() noexcept;
+    void processLight(const float* input, float* output, size_t numSamples, bool crossfade) noexcept;
+
+    // Message thread: the response as loaded, and what the tail gets designed for
+    juce::AudioBuffer<float> impulseResponse;
+    double impulseResponseSampleRate { 0 };
+    double sampleRate { 0 };
+    int partitionSize { 0 }, headPartitionSize { 0 };
+    double maximumSeconds { 0 };
+    std::atomic<bool> threadedTail { false };
+
+    // Audio thread. The job is declared before the responses, which wait on it, and those before the
+    // publisher, whose handles point into them. A response stays held while any of these points to it.
+    TailJob job;
+    juce::OwnedArray<Response> responses;
+    juce::CriticalSection responsesLock;
+    SnapshotPublisher<ResponseHandle> responsePublisher;
+    juce::uint64 responseGeneration { 0 };
+    const Response* activeResponse { nullptr };
+    const Response* fadingTail { nullptr };     // until its fade goes to the job
+    const Response* fadeSubmitted { nullptr };  // until the job has done that partition
+    const Response* headResponse { nullptr };   // the head that runs, behind activeResponse until its fade
+    const Response* fadingHead { nullptr };     // for the partition the old tail fades out in
+    const Response* pendingHead { nullptr };
+    int headFadeDelay { 0 };                    // partitions until pendingHead's fade starts
+
+    std::vector<float> dry, pendingInput, jobInput, fadeScratch, headScratch;
+    std::array<std::vector<float>, 2> tailOutputs;
+    int inputFill { 0 }, outputIndex { -1 };
+    bool jobPending { false }, nonRealtime { false };
+
+    // Message thread: the response to fit next, taken by whichever thread fits it. fitLock keeps the
+    // fits in order, responseLock is only held to hand the response over.
+    std::vector<float> fitResponse;
+    double fitSampleRate { 0 };
+    bool fitPending { false };
+    juce::CriticalSection fitLock, responseLock;
+
+    // Audio thread: the latest fit copied into the cascades, and the mix between the two paths
+    std::atomic<bool> lightMode { false };
+    SnapshotPublisher<LightDesign> lightPublisher;
+    juce::uint64 lightGeneration { 0 };
+    bool lightReady { false };
+    std::array<FilterCascade<4>, CabinetFit::maxSections / 4> lightCascades;
+    std::vector<float> lightOutput;
+    juce::SmoothedValue<float> lightMix;
+
+    juce::SharedResourcePointer<WorkerPool> workerPool;
+    juce::SharedResourcePointer<BackgroundThread> backgroundThread;
+};
@@ -0,0 +1,462 @@
+/*
+  ==============================================================================
+
+    CabinetFit.cpp
+    Created: 27 Oct 2026 9:48:31am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "CabinetFit.h"
+#include "Trace.h"
+
+namespace
+{
+    constexpr int numGridPoints = 192;
+    constexpr double lowestFrequency = 30.0, highestFrequency = 18000.0;
+
+    // The target doesn't go further than this below its loudest point, there is nothing to hear there
+    constexpr double floorDecibels = 60.0;
+
+    struct Biquad
+    {
+        double b0, b1, b2, a0, a1, a2;
+    };
+
+    struct Section
+    {
+        enum class Type
+        {
+            highPass,
+            lowPass,
+            peak
+        };
+
+        Type type;
+        double frequency, q, gainDecibels;
+
+        int getNumParameters() const noexcept   { return type == Type::peak ? 3 : 2; }
+    };
+
+    // The audio EQ cookbook's designs
+    Biquad design(const Section& section, double sampleRate) noexcept
+    {
+        auto w0 = juce::MathConstants<double>::twoPi * section.frequency / sampleRate;
+        auto c = std::cos(w0);
+        auto alpha = std::sin(w0) / (2.0 * section.q);
+
+        switch (section.type)
+        {
+        case Section::Type::highPass:
+            return { (1 + c) / 2, -(1 + c), (1 + c) / 2, 1 + alpha, -2 * c, 1 - alpha };
+
+        case Section::Type::lowPass:
+            return { (1 - c) / 2, 1 - c, (1 - c) / 2, 1 + alpha, -2 * c, 1 - alpha };
+
+        case Section::Type::peak:
+        default:
+        {
+            auto A = std::pow(10.0, section.gainDecibels / 40.0);
+            return { 1 + alpha * A, -2 * c, 1 - alpha * A, 1 + alpha / A, -2 * c, 1 - alpha / A };
+        }
+        }
+    }
+
+    // The frequencies the fit looks at, and the smoothed response there in dB
+    struct Grid
+    {
+        std::vector<double> frequency, cosW, cos2W, target;
+    };
+
+    Grid makeGrid(const float* response, int length, double sampleRate)
+    {
+        auto order = juce::jlimit(12, 16, (int)std::ceil(std::log2((double)juce::jmax(1, length))));
+        auto size = 1 << order;
+
+        juce::dsp::FFT fft(order);
+        std::vector<float> spectrum((size_t)size * 2, 0.f);
+        std::copy(response, response + juce::jmin(length, size), spectrum.begin());
+        fft.performFrequencyOnlyForwardTransform(spectrum.data());
+
+        auto binWidth = sampleRate / (double)size;
+        auto top = juce::jmin(highestFrequency, 0.45 * sampleRate);
+
+        Grid grid;
+
+        for (int i = 0; i < numGridPoints; ++i)
+        {
+            auto f = lowestFrequency * std::pow(top / lowestFrequency, (double)i / (double)(numGridPoints - 1));
+
+            // the bins within a twelfth of an octave either side, or the nearest one
+            auto first = (int)std::ceil(f * std::pow(2.0, -1.0 / 12.0) / binWidth);
+            auto last = (int)std::floor(f * std::pow(2.0, 1.0 / 12.0) / binWidth);
+
+            if (last < first)
+                first = last = juce::roundToInt(f / binWidth);
+
+            first = juce::jlimit(1, size / 2, first);
+            last = juce::jlimit(first, size / 2, last);
+
+            double power = 0;
+
+            for (int k = first; k <= last; ++k)
+                power += (double)spectrum[(size_t)k] * spectrum[(size_t)k];
+
+            auto w = juce::MathConstants<double>::twoPi * f / sampleRate;
+
+            grid.frequency.push_back(f);
+            grid.cosW.push_back(std::cos(w));
+            grid.cos2W.push_back(std::cos(2 * w));
+            grid.target.push_back(10.0 * std::log10(power / (double)(last - first + 1) + 1.0e-30));
+        }
+
+        auto loudest = *std::max_element(grid.target.begin(), grid.target.end());
+
+        for (auto& t : grid.target)
+            t = juce::jmax(t, loudest - floorDecibels);
+
+        return grid;
+    }
+
+    // |p0 + p1 z^-1 + p2 z^-2|^2 on the unit circle
+    double squaredMagnitude(double p0, double p1, double p2, double cosW, double cos2W) noexcept
+    {
+        return p0 * p0 + p1 * p1 + p2 * p2 + 2 * (p0 * p1 + p1 * p2) * cosW + 2 * p0 * p2 * cos2W;
+    }
+
+    // The sections and an overall gain, as a vector of parameters for the solver: the gain, then
+    // each section's log frequency, log Q and, for peaks, gain. Values out of range get clamped.
+    class Model
+    {
+    public:
+        Model(const Grid& newGrid, double newSampleRate) : grid(newGrid), sampleRate(newSampleRate) {}
+
+        void addSection(const Section& section)
+        {
+            sections.push_back(section);
+            sectionDecibels.emplace_back(grid.target.size());
+            setParameters(getParameters());
+        }
+
+        size_t getNumSections() const noexcept  { return sections.size(); }
+
+        std::vector<double> getParameters() const
+        {
+            std::vector<double> parameters { gainDecibels };
+
+            for (auto& section : sections)
+            {
+                parameters.push_back(std::log(section.frequency));
+                parameters.push_back(std::log(section.q));
+
+                if (section.type == Section::Type::peak)
+                    parameters.push_back(section.gainDecibels);
+            }
+
+            return parameters;
+        }
+
+        void setParameters(const std::vector<double>& parameters)
+        {
+            gainDecibels = juce::jlimit(-80.0, 40.0, parameters[0]);
+            size_t index = 1;
+
+            for (size_t s = 0; s < sections.size(); ++s)
+            {
+                index = readSection(sections[s], parameters, index);
+                computeResponse(sections[s], sectionDecibels[s]);
+            }
+        }
+
+        // In dB on the grid
+        void evaluate(std::vector<double>& decibels) const
+        {
+            std::fill(decibels.begin(), decibels.end(), gainDecibels);
+
+            for (auto& section : sectionDecibels)
+                for (size_t i = 0; i < decibels.size(); ++i)
+                    decibels[i] += section[i];
+        }
+
+        // Forward differences, row i column j is d decibels[i] / d parameters[j]. A parameter only
+        // moves its own section, so a column costs one section's response.
+        void computeJacobian(std::vector<double>& jacobian) const
+        {
+            auto parameters = getParameters();
+            auto numParameters = parameters.size();
+            auto numPoints = grid.target.size();
+
+            std::vector<double> moved(numPoints);
+
+            for (size_t i = 0; i < numPoints; ++i)
+                jacobian[i * numParameters] = 1.0;
+
+            size_t index = 1;
+
+            for (size_t s = 0; s < sections.size(); ++s)
+            {
+                for (int p = 0; p < sections[s].getNumParameters(); ++p)
+                {
+                    constexpr double step = 1.0e-5;
+
+                    auto shifted = parameters;
+                    shifted[index + (size_t)p] += step;
+
+                    auto section = sections[s];
+                    readSection(section, shifted, index);
+                    computeResponse(section, moved);
+
+                    for (size_t i = 0; i < numPoints; ++i)
+                        jacobian[i * numParameters + index + (size_t)p] = (moved[i] - sectionDecibels[s][i]) / step;
+                }
+
+                index += (size_t)sections[s].getNumParameters();
+            }
+        }
+
+        // Each design in float, with the overall gain taken into the first one
+        juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeCoefficients() const
+        {
+            juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> coefficients;
+            auto gain = juce::Decibels::decibelsToGain(gainDecibels, -200.0);
+
+            for (auto& section : sections)
+            {
+                auto b = design(section, sampleRate);
+                auto g = coefficients.isEmpty() ? gain : 1.0;
+
+                coefficients.add(new juce::dsp::IIR::Coefficients<float>((float)(b.b0 * g), (float)(b.b1 * g), (float)(b.b2 * g),
+                                                                         (float)b.a0, (float)b.a1, (float)b.a2));
+            }
+
+            return coefficients;
+        }
+
+    private:
+        size_t readSection(Section& section, const std::vector<double>& parameters, size_t index) const
+        {
+            section.frequency = juce::jlimit(20.0, 0.45 * sampleRate, std::exp(parameters[index++]));
+            section.q = juce::jlimit(0.3, 6.0, std::exp(parameters[index++]));
+
+            if (section.type == Section::Type::peak)
+                section.gainDecibels = juce::jlimit(-30.0, 20.0, parameters[index++]);
+
+            return index;
+        }
+
+        void computeResponse(const Section& section, std::vector<double>& decibels) const
+        {
+            auto b = design(section, sampleRate);
+
+            for (size_t i = 0; i < decibels.size(); ++i)
+            {
+                auto numerator = squaredMagnitude(b.b0, b.b1, b.b2, grid.cosW[i], grid.cos2W[i]);
+                auto denominator = squaredMagnitude(b.a0, b.a1, b.a2, grid.cosW[i], grid.cos2W[i]);
+                decibels[i] = 10.0 * std::log10(juce::jmax(numerator, 1.0e-30) / juce::jmax(denominator, 1.0e-30));
+            }
+        }
+
+        const Grid& grid;
+        double sampleRate;
+
+        std::vector<Section> sections;
+        std::vector<std::vector<double>> sectionDecibels;
+        double gainDecibels { 0 };
+    };
+
+    double squaredError(const std::vector<double>& model, const std::vector<double>& target) noexcept
+    {
+        double sum = 0;
+
+        for (size_t i = 0; i < model.size(); ++i)
+            sum += (model[i] - target[i]) * (model[i] - target[i]);
+
+        return sum;
+    }
+
+    // Solves a x = b in place by Gaussian elimination with partial pivoting, false when a is singular
+    bool solve(std::vector<double>& a, std::vector<double>& b, size_t n)
+    {
+        for (size_t column = 0; column < n; ++column)
+        {
+            auto pivot = column;
+
+            for (size_t row = column + 1; row < n; ++row)
+                if (std::abs(a[row * n + column]) > std::abs(a[pivot * n + column]))
+                    pivot = row;
+
+            if (std::abs(a[pivot * n + column]) < 1.0e-300)
+                return false;
+
+            if (pivot != column)
+            {
+                for (size_t k = 0; k < n; ++k)
+                    std::swap(a[column * n + k], a[pivot * n + k]);
+
+                std::swap(b[column], b[pivot]);
+            }
+
+            for (size_t row = column + 1; row < n; ++row)
+            {
+                auto factor = a[row * n + column] / a[column * n + column];
+
+                for (size_t k = column; k < n; ++k)
+                    a[row * n + k] -= factor * a[column * n + k];
+
+                b[row] -= factor * b[column];
+            }
+        }
+
+        for (size_t row = n; row-- > 0;)
+        {
+            for (size_t k = row + 1; k < n; ++k)
+                b[row] -= a[row * n + k] * b[k];
+
+            b[row] /= a[row * n + row];
+        }
+
+        return true;
+    }
+
+    // Levenberg-Marquardt on the squared dB error, every parameter at once
+    void refine(Model& model, const Grid& grid, int maxIterations)
+    {
+        auto parameters = model.getParameters();
+        auto numParameters = parameters.size();
+        auto numPoints = grid.target.size();
+
+        std::vector<double> current(numPoints), trial(numPoints), jacobian(numPoints * numParameters);
+        std::vector<double> normal(numParameters * numParameters), gradient(numParameters);
+
+        model.evaluate(current);
+        auto currentError = squaredError(current, grid.target);
+        auto lambda = 1.0e-2;
+
+        for (int iteration = 0; iteration < maxIterations; ++iteration)
+        {
+            model.computeJacobian(jacobian);
+
+            for (size_t r = 0; r < numParameters; ++r)
+            {
+                for (size_t c = 0; c <= r; ++c)
+                {
+                    double sum = 0;
+
+                    for (size_t i = 0; i < numPoints; ++i)
+                        sum += jacobian[i * numParameters + r] * jacobian[i * numParameters + c];
+
+                    normal[r * numParameters + c] = normal[c * numParameters + r] = sum;
+                }
+
+                double sum = 0;
+
+                for (size_t i = 0; i < numPoints; ++i)
+                    sum += jacobian[i * numParameters + r] * (grid.target[i] - current[i]);
+
+                gradient[r] = sum;
+            }
+
+            auto previousError = currentError;
+            auto improved = false;
+
+            for (int attempt = 0; attempt < 10 && ! improved; ++attempt)
+            {
+                auto damped = normal;
+                auto step = gradient;
+
+                for (size_t r = 0; r < numParameters; ++r)
+                    damped[r * numParameters + r] += lambda * damped[r * numParameters + r] + 1.0e-9;
+
+                if (! solve(damped, step, numParameters))
+                {
+                    lambda *= 10;
+                    continue;
+                }
+
+                auto moved = parameters;
+
+                for (size_t r = 0; r < numParameters; ++r)
+                    moved[r] += step[r];
+
+                model.setParameters(moved);
+                model.evaluate(trial);
+                auto trialError = squaredError(trial, grid.target);
+
+                if (trialError < currentError)
+                {
+                    // read back, clamped
+                    parameters = model.getParameters();
+                    std::swap(current, trial);
+                    currentError = trialError;
+                    lambda = juce::jmax(lambda / 3, 1.0e-7);
+                    improved = true;
+                }
+                else
+                {
+                    lambda *= 4;
+                }
+            }
+
+            if (! improved)
+            {
+                model.setParameters(parameters);
+                return;
+            }
+
+            if (previousError - currentError < 1.0e-6 * previousError)
+                return;
+        }
+    }
+}
+
+CabinetFit::Result CabinetFit::fit(const float* response, int length, double sampleRate, int numSections)
+{
+    TRACE_SCOPE("Cabinet fit");
+
+    Result result;
+
+    if (response == nullptr || length <= 0 || sampleRate <= 0)
+        return result;
+
+    jassert(numSections >= 2);
+    numSections = juce::jlimit(2, maxSections, numSections);
+
+    auto grid = makeGrid(response, length, sampleRate);
+
+    // The cabinet's band first, at about the level of its loudest part
+    Model model(grid, sampleRate);
+    model.addSection({ Section::Type::highPass, 70.0, 0.7, 0.0 });
+    model.addSection({ Section::Type::lowPass, 6000.0, 0.7, 0.0 });
+
+    auto parameters = model.getParameters();
+    parameters[0] = *std::max_element(grid.target.begin(), grid.target.end());
+    model.setParameters(parameters);
+
+    refine(model, grid, 30);
+
+    // Then a peak where the error is largest, until the sections run out
+    std::vector<double> current(grid.target.size());
+
+    while ((int)model.getNumSections() < numSections)
+    {
+        model.evaluate(current);
+
+        size_t worst = 0;
+
+        for (size_t i = 1; i < current.size(); ++i)
+            if (std::abs(grid.target[i] - current[i]) > std::abs(grid.target[worst] - current[worst]))
+                worst = i;
+
+        model.addSection({ Section::Type::peak, grid.frequency[worst], 1.4, grid.target[worst] - current[worst] });
+        refine(model, grid, 10);
+    }
+
+    refine(model, grid, 100);
+
+    model.evaluate(current);
+    result.sections = model.makeCoefficients();
+    result.errorDecibels = std::sqrt(squaredError(current, grid.target) / (double)current.size());
+
+    return result;
+}
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    CabinetFit.h
+    Created: 27 Oct 2026 9:48:31am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Fits the magnitude response of a cabinet impulse response with a cascade of biquads, for the light
+// cabinet: a high pass, a low pass and peaking sections. The target is the response smoothed to a sixth
+// of an octave, on a log frequency grid from 30 Hz to 18 kHz (or 0.45 of the rate, if that's lower).
+//
+// Every section is minimum phase, so the cascade adds no latency. Only the magnitude is matched: the
+// phase and the decay of the response are lost.
+//
+// The fit starts with the two passes, adds one peak at a time where the error is largest, and moves
+// every section at once with Levenberg-Marquardt after each one. Tens of milliseconds for 16
+// sections, so run it on the background thread.
+class CabinetFit
+{
+public:
+    static constexpr int maxSections = 16;
+
+    struct Result
+    {
+        juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> sections;
+        double errorDecibels { 0 };     // RMS over the grid, against the smoothed response
+    };
+
+    // response is at sampleRate. Empty sections when there is nothing to fit.
+    static Result fit(const float* response, int length, double sampleRate, int numSections = maxSections);
+};
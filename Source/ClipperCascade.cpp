@@ -0,0 +1,344 @@
+/*
+  ==============================================================================
+
+    ClipperCascade.cpp
+    Created: 19 Oct 2026 5:20:43pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "ClipperCascade.h"
+
+ClipperCascade::OnePole ClipperCascade::OnePole::highPass(float frequency, double sampleRate) noexcept
+{
+    auto k = (float)std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+    auto b0 = 1.f / (1.f + k);
+    return { b0, -b0, (k - 1.f) / (k + 1.f) };
+}
+
+ClipperCascade::OnePole ClipperCascade::OnePole::lowPass(float frequency, double sampleRate) noexcept
+{
+    auto k = (float)std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+    auto b0 = k / (1.f + k);
+    return { b0, b0, (k - 1.f) / (k + 1.f) };
+}
+
+float ClipperCascade::getLatencyInSamples(int order) const noexcept
+{
+    auto& oversampling = engines[(size_t)juce::jlimit(0, maxOversamplingOrder, order)].oversampling;
+    return oversampling != nullptr ? oversampling->getLatencyInSamples() : 0.f;
+}
+
+void ClipperCascade::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    for (int order = 0; order <= maxOversamplingOrder; ++order)
+    {
+        auto& engine = engines[(size_t)order];
+
+        engine.oversampling = std::make_unique<juce::dsp::Oversampling<float>>(spec.numChannels, (size_t)order,
+                                                                                juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+                                                                                true, true);
+        engine.oversampling->initProcessing(spec.maximumBlockSize);
+
+        auto factor = engine.oversampling->getOversamplingFactor();
+        juce::dsp::ProcessSpec oversampledSpec { spec.sampleRate * (double)factor,
+                                                 (juce::uint32)(spec.maximumBlockSize * factor),
+                                                 spec.numChannels };
+
+        for (auto& stage : engine.stages)
+            stage.prepare(oversampledSpec);
+
+        engine.highPass = OnePole::highPass(interstageHighPassFrequency, oversampledSpec.sampleRate);
+        engine.lowPass = OnePole::lowPass(interstageLowPassFrequency, oversampledSpec.sampleRate);
+
+        engine.channelStates.resize(juce::jmax((size_t)1, (size_t)spec.numChannels));
+    }
+
+    otherBuffer.setSize(juce::jmax(1, (int)spec.numChannels), (int)spec.maximumBlockSize);
+    history.setSize(otherBuffer.getNumChannels(), historyLength);
+
+    reset();
+}
+
+void ClipperCascade::Engine::reset() noexcept
+{
+    if (oversampling != nullptr)
+        oversampling->reset();
+
+    for (auto& s : channelStates)
+        s = {};
+}
+
+void ClipperCascade::reset() noexcept
+{
+    for (auto& engine : engines)
+        engine.reset();
+
+    fadingOrder = -1;
+    history.clear();
+    historyPosition = 0;
+}
+
+void ClipperCascade::copyStateFrom(const ClipperCascade& other) noexcept
+{
+    jassert(other.history.getNumChannels() == history.getNumChannels());
+
+    oversamplingOrder = other.oversamplingOrder;
+    preparedOrder = other.preparedOrder;
+    fadingOrder = other.fadingOrder;
+
+    for (int ch = 0; ch < history.getNumChannels(); ++ch)
+        history.copyFrom(ch, 0, other.history, ch, 0, historyLength);
+
+    historyPosition = other.historyPosition;
+
+    // The engines that run, the other one only when it differs
+    std::array<int, 2> orders { oversamplingOrder, fadingOrder >= 0 ? fadingOrder : preparedOrder };
+
+    for (size_t n = 0; n < orders.size(); ++n)
+    {
+        auto order = orders[n];
+
+        if (n > 0 && order == orders[0])
+            break;
+
+        auto& engine = engines[(size_t)order];
+        engine.reset();
+
+        // oldest first, through otherBuffer a block at a time
+        for (int done = 0; done < historyLength;)
+        {
+            auto start = (historyPosition + done) % historyLength;
+            auto count = juce::jmin(historyLength - done, historyLength - start, otherBuffer.getNumSamples());
+
+            for (int ch = 0; ch < history.getNumChannels(); ++ch)
+                otherBuffer.copyFrom(ch, 0, history, ch, start, count);
+
+            auto block = juce::dsp::AudioBlock<float>(otherBuffer).getSubBlock(0, (size_t)count);
+            processEngine(engine, block, block);
+            done += count;
+        }
+
+        // what the cascade keeps itself is copied exactly
+        engine.channelStates = other.engines[(size_t)order].channelStates;
+    }
+}
+
+void ClipperCascade::setOversamplingOrder(int newOrder) noexcept
+{
+    newOrder = juce::jlimit(0, maxOversamplingOrder, newOrder);
+
+    if (newOrder != oversamplingOrder)
+    {
+        oversamplingOrder = newOrder;
+        engines[(size_t)newOrder].reset();
+    }
+
+    preparedOrder = oversamplingOrder;
+    fadingOrder = -1;
+}
+
+void ClipperCascade::prepareOversamplingOrder(int newOrder) noexcept
+{
+    newOrder = juce::jlimit(0, maxOversamplingOrder, newOrder);
+
+    if (newOrder == preparedOrder)
+        return;
+
+    preparedOrder = newOrder;
+
+    // one still fading out has its history
+    if (newOrder != oversamplingOrder && newOrder != fadingOrder)
+        engines[(size_t)newOrder].reset();
+}
+
+void ClipperCascade::switchToPreparedOrder() noexcept
+{
+    if (preparedOrder == oversamplingOrder)
+        return;
+
+    fadingOrder = oversamplingOrder;
+    oversamplingOrder = preparedOrder;
+}
+
+void ClipperCascade::pushHistory(const juce::dsp::AudioBlock<const float>& block) noexcept
+{
+    auto numSamples = (int)block.getNumSamples();
+    auto numChannels = juce::jmin((int)block.getNumChannels(), history.getNumChannels());
+
+    // only the newest historyLength samples stay
+    for (auto position = juce::jmax(0, numSamples - historyLength); position < numSamples;)
+    {
+        auto count = juce::jmin(numSamples - position, historyLength - historyPosition);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            history.copyFrom(ch, historyPosition, block.getChannelPointer((size_t)ch) + position, count);
+
+        position += count;
+        historyPosition = (historyPosition + count) % historyLength;
+    }
+}
+
+void ClipperCascade::processEngine(Engine& engine, const juce::dsp::AudioBlock<const float>& inputBlock,
+                                   juce::dsp::AudioBlock<float>& outputBlock) noexcept
+{
+    jassert(engine.oversampling != nullptr);
+
+    auto oversampledBlock = engine.oversampling->processSamplesUp(inputBlock);
+
+    for (size_t ch = 0; ch < oversampledBlock.getNumChannels(); ++ch)
+        processOversampled(engine, oversampledBlock.getChannelPointer(ch), oversampledBlock.getNumSamples(),
+                           engine.channelStates[juce::jmin(ch, engine.channelStates.size() - 1)]);
+
+    engine.oversampling->processSamplesDown(outputBlock);
+}
+
+void ClipperCascade::crossfade(const juce::dsp::AudioBlock<float>& from, juce::dsp::AudioBlock<float>& to) noexcept
+{
+    auto numSamples = to.getNumSamples();
+
+    for (size_t ch = 0; ch < to.getNumChannels(); ++ch)
+    {
+        auto* old = from.getChannelPointer(ch);
+        auto* data = to.getChannelPointer(ch);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            data[i] = old[i] + (data[i] - old[i]) * ((float)i + 0.5f) / (float)numSamples;
+    }
+}
+
+void ClipperCascade::setType(ClipperType newType) noexcept
+{
+    type = newType;
+    forEachStage([newType] (ClipperStage& stage) { stage.setType(newType); });
+}
+
+void ClipperCascade::setDrive(float firstStageDrive) noexcept
+{
+    drives[0] = firstStageDrive;
+
+    for (auto& engine : engines)
+        engine.stages[0].setDrive(firstStageDrive);
+}
+
+void ClipperCascade::setStageDrive(float laterStagesDrive) noexcept
+{
+    for (int i = 1; i < maxStages; ++i)
+    {
+        drives[(size_t)i] = laterStagesDrive;
+
+        for (auto& engine : engines)
+            engine.stages[(size_t)i].setDrive(laterStagesDrive);
+    }
+}
+
+void ClipperCascade::setAntiderivativeAntialiasing(bool shouldUseADAA) noexcept
+{
+    useADAA = shouldUseADAA;
+    forEachStage([shouldUseADAA] (ClipperStage& stage) { stage.setAntiderivativeAntialiasing(shouldUseADAA); });
+}
+
+void ClipperCascade::setUseApproximations(bool shouldApproximate) noexcept
+{
+    useApproximations = shouldApproximate;
+    forEachStage([shouldApproximate] (ClipperStage& stage) { stage.setUseApproximations(shouldApproximate); });
+}
+
+void ClipperCascade::setDiodeNewtonIterations(int numIterations) noexcept
+{
+    forEachStage([numIterations] (ClipperStage& stage) { stage.setDiodeNewtonIterations(numIterations); });
+}
+
+void ClipperCascade::processOversampled(Engine& engine, float* data, size_t numSamples, ChannelState& state) noexcept
+{
+    if (useADAA || type == ClipperType::Diode)
+    {
+        processStaged(engine, data, numSamples, state);
+        return;
+    }
+
+    // Nothing feeds back into the first stage, ClipperStage runs it over the block as the vector kernel.
+    // The stages after it go through the interstage filters sample by sample, those get fused.
+    engine.stages[0].processChannel(data, data, numSamples, state.stages[0]);
+
+    if (numStages == 1)
+        return;
+
+    switch (type)
+    {
+    case ClipperType::Atan:
+        useApproximations ? processFused<clippers::Atan, true>(engine, data, numSamples, state)
+                          : processFused<clippers::Atan, false>(engine, data, numSamples, state);
+        break;
+    case ClipperType::Tanh:
+        useApproximations ? processFused<clippers::Tanh, true>(engine, data, numSamples, state)
+                          : processFused<clippers::Tanh, false>(engine, data, numSamples, state);
+        break;
+    case ClipperType::Cubic:        processFused<clippers::Cubic, true>(engine, data, numSamples, state); break;
+    case ClipperType::Hard:         processFused<clippers::Hard, true>(engine, data, numSamples, state); break;
+    case ClipperType::Asymmetric:   processFused<clippers::Asymmetric, true>(engine, data, numSamples, state); break;
+    case ClipperType::Diode:
+    default:                        jassertfalse; break;
+    }
+}
+
+void ClipperCascade::processStaged(Engine& engine, float* data, size_t numSamples, ChannelState& state) noexcept
+{
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        if (stage > 0)
+        {
+            auto& interstage = state.interstage[(size_t)stage - 1];
+
+            for (size_t i = 0; i < numSamples; ++i)
+                data[i] = interstage.process(data[i], engine.highPass, engine.lowPass);
+        }
+
+        engine.stages[(size_t)stage].processChannel(data, data, numSamples, state.stages[(size_t)stage]);
+    }
+}
+
+template <typename Curve, bool useApproximation>
+void ClipperCascade::processFused(const Engine& engine, float* data, size_t numSamples, ChannelState& state) noexcept
+{
+    switch (numStages)
+    {
+    case 2:     processFusedStages<Curve, useApproximation, 2>(engine, data, numSamples, state); break;
+    case 3:     processFusedStages<Curve, useApproximation, 3>(engine, data, numSamples, state); break;
+    case 4:     processFusedStages<Curve, useApproximation, 4>(engine, data, numSamples, state); break;
+    default:    jassertfalse; break;
+    }
+}
+
+template <typename Curve, bool useApproximation, int NumStages>
+void ClipperCascade::processFusedStages(const Engine& engine, float* data, size_t numSamples, ChannelState& state) noexcept
+{
+    // Work on local copies so the filter states can stay in registers for the whole block
+    auto interstage = state.interstage;
+    const auto hp = engine.highPass;
+    const auto lp = engine.lowPass;
+    const auto stageDrives = drives;
+
+    auto clip = [] (float u) noexcept {
+        if constexpr (useApproximation)
+            return Curve::process(u);
+        else
+            return Curve::processExact(u);
+    };
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto x = data[i];
+
+        for (int stage = 1; stage < NumStages; ++stage)
+        {
+            x = interstage[(size_t)stage - 1].process(x, hp, lp);
+            x = clip(stageDrives[(size_t)stage] * x) + x;
+        }
+
+        data[i] = x;
+    }
+
+    state.interstage = interstage;
+}
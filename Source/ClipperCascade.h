@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    ClipperCascade.h
+    Created: 19 Oct 2026 5:20:43pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Clippers.h"
+
+// The Clipping position of the chain: 1 to 4 clipping stages, like the gain stages of a tube preamp,
+// with a coupling high pass, a plate low pass and some attenuation between them.
+//
+// The whole cascade runs inside one oversampled region, so the up and down sampling is paid once.
+// For the static curves the first stage runs over the block through ClipperStage's dispatched vector
+// kernel, and the stages after it are fused with the interstage filters into a single loop,
+// instantiated per curve and per number of stages. ADAA and the diode model keep per stage state,
+// those run stage after stage.
+//
+// Every oversampling factor is prepared up front, so the factor can change between blocks
+// without allocating. A factor asked for with prepareOversamplingOrder() runs alongside the current
+// one, its output unused, until switchToPreparedOrder(); then the two are crossfaded over a block.
+class ClipperCascade
+{
+public:
+    static constexpr int maxStages = 4;
+    static constexpr int maxOversamplingOrder = 3;
+
+    static constexpr float interstageHighPassFrequency = 120.f;
+    static constexpr float interstageLowPassFrequency = 7000.f;
+    static constexpr float interstageGain = 0.5f;
+
+    // Input samples kept for copyStateFrom(), long after the oversampling filters have forgotten them
+    static constexpr int historyLength = 256;
+
+    // 2^order times oversampling. Realtime safe, the newly selected factor starts from silence.
+    void setOversamplingOrder(int newOrder) noexcept;
+    int getOversamplingOrder() const noexcept   { return oversamplingOrder; }
+
+    // Realtime safe. Starts running newOrder's engine from silence next to the current one, so it
+    // has history by the time it takes over. The current order cancels that.
+    void prepareOversamplingOrder(int newOrder) noexcept;
+    int getPreparedOversamplingOrder() const noexcept   { return preparedOrder; }
+
+    // The prepared order becomes the current one, its latency too. The next block fades the old one out.
+    void switchToPreparedOrder() noexcept;
+    float getLatencyInSamples() const noexcept  { return getLatencyInSamples(oversamplingOrder); }
+    float getLatencyInSamples(int order) const noexcept;
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset() noexcept;
+
+    // Realtime safe. Picks up where other is, prepared alike, as if this one had been running on the same
+    // input. Juce's oversampling filters don't give their state away, they get the last historyLength
+    // input samples replayed instead; the rest is copied.
+    void copyStateFrom(const ClipperCascade& other) noexcept;
+
+    void setNumStages(int newNumStages) noexcept    { numStages = juce::jlimit(1, maxStages, newNumStages); }
+    void setType(ClipperType newType) noexcept;
+    void setDrive(float firstStageDrive) noexcept;
+    void setStageDrive(float laterStagesDrive) noexcept;
+    void setAntiderivativeAntialiasing(bool shouldUseADAA) noexcept;
+    void setUseApproximations(bool shouldApproximate) noexcept;
+    void setDiodeNewtonIterations(int numIterations) noexcept;
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto&& inputBlock = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+
+            return;
+        }
+
+        pushHistory(inputBlock);
+
+        // The other engine, fading out or warming up, runs on a copy of the input
+        auto otherOrder = fadingOrder >= 0 ? fadingOrder : preparedOrder;
+        juce::dsp::AudioBlock<float> otherBlock;
+
+        if (otherOrder != oversamplingOrder)
+        {
+            otherBlock = juce::dsp::AudioBlock<float>(otherBuffer).getSubsetChannelBlock(0, inputBlock.getNumChannels())
+                                                                  .getSubBlock(0, inputBlock.getNumSamples());
+            otherBlock.copyFrom(inputBlock);
+            processEngine(engines[(size_t)otherOrder], otherBlock, otherBlock);
+        }
+
+        processEngine(engines[(size_t)oversamplingOrder], inputBlock, outputBlock);
+
+        if (fadingOrder >= 0)
+        {
+            crossfade(otherBlock, outputBlock);
+            fadingOrder = -1;
+        }
+    }
+
+private:
+    struct OnePole
+    {
+        float b0 { 1 }, b1 { 0 }, a1 { 0 };
+
+        static OnePole highPass(float frequency, double sampleRate) noexcept;
+        static OnePole lowPass(float frequency, double sampleRate) noexcept;
+    };
+
+    struct InterstageState
+    {
+        float highPassX1 { 0 }, highPassY1 { 0 }, lowPassX1 { 0 }, lowPassY1 { 0 };
+
+        float process(float x, const OnePole& highPass, const OnePole& lowPass) noexcept
+        {
+            auto h = highPass.b0 * x + highPass.b1 * highPassX1 - highPass.a1 * highPassY1;
+            highPassX1 = x;
+            highPassY1 = h;
+
+            auto l = lowPass.b0 * h + lowPass.b1 * lowPassX1 - lowPass.a1 * lowPassY1;
+            lowPassX1 = h;
+            lowPassY1 = l;
+
+            return l * interstageGain;
+        }
+    };
+
+    struct ChannelState
+    {
+        std::array<InterstageState, maxStages - 1> interstage;
+        std::array<ClipperStage::ChannelState, maxStages> stages;
+    };
+
+    // Everything that depends on the oversampled rate
+    struct Engine
+    {
+        std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+        std::array<ClipperStage, maxStages> stages;
+        OnePole highPass, lowPass;
+        std::vector<ChannelState> channelStates = std::vector<ChannelState>(1);
+
+        void reset() noexcept;
+    };
+
+    void pushHistory(const juce::dsp::AudioBlock<const float>& block) noexcept;
+    void processEngine(Engine& engine, const juce::dsp::AudioBlock<const float>& inputBlock,
+                       juce::dsp::AudioBlock<float>& outputBlock) noexcept;
+    static void crossfade(const juce::dsp::AudioBlock<float>& from, juce::dsp::AudioBlock<float>& to) noexcept;
+    void processOversampled(Engine& engine, float* data, size_t numSamples, ChannelState& state) noexcept;
+    void processStaged(Engine& engine, float* data, size_t numSamples, ChannelState& state) noexcept;
+
+    template <typename Curve, bool useApproximation>
+    void processFused(const Engine& engine, float* data, size_t numSamples, ChannelState& state) noexcept;
+
+    template <typename Curve, bool useApproximation, int NumStages>
+    void processFusedStages(const Engine& engine, float* data, size_t numSamples, ChannelState& state) noexcept;
+
+    template <typename Function>
+    void forEachStage(Function&& function)
+    {
+        for (auto& engine : engines)
+            for (auto& stage : engine.stages)
+                function(stage);
+    }
+
+    std::array<Engine, maxOversamplingOrder + 1> engines;
+    int oversamplingOrder { 2 }, preparedOrder { 2 }, fadingOrder { -1 };
+    juce::AudioBuffer<float> otherBuffer, history;
+    int historyPosition { 0 };
+
+    std::array<float, maxStages> drives {};
+
+    ClipperType type { ClipperType::Atan };
+    int numStages { 1 };
+    bool useADAA { false }, useApproximations { false };
+};
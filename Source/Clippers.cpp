@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    Clippers.cpp
+    Created: 19 Oct 2026 1:26:08pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Clippers.h"
+#include "SimdKernels.h"
+
+juce::StringArray ClipperStage::getTypeNames()
+{
+    return { "Atan", "Tanh", "Cubic", "Hard", "Asymmetric", "Diode" };
+}
+
+void ClipperStage::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    states.resize(juce::jmax((size_t)1, (size_t)spec.numChannels));
+    diode.prepare(spec.sampleRate);
+    reset();
+}
+
+void ClipperStage::reset() noexcept
+{
+    for (auto& s : states)
+        s = {};
+}
+
+void ClipperStage::processChannel(const float* input, float* output, size_t numSamples, ChannelState& state) noexcept
+{
+    switch (type)
+    {
+    case ClipperType::Atan:         processWith<clippers::Atan>(input, output, numSamples, state); break;
+    case ClipperType::Tanh:         processWith<clippers::Tanh>(input, output, numSamples, state); break;
+    case ClipperType::Cubic:        processWith<clippers::Cubic>(input, output, numSamples, state); break;
+    case ClipperType::Hard:         processWith<clippers::Hard>(input, output, numSamples, state); break;
+    case ClipperType::Asymmetric:   processWith<clippers::Asymmetric>(input, output, numSamples, state); break;
+    case ClipperType::Diode:        diode.processChannel(input, output, numSamples, state.diode); break;
+    default:                        jassertfalse; break;
+    }
+}
+
+template <typename Curve>
+void ClipperStage::processWith(const float* input, float* output, size_t numSamples, ChannelState& state) noexcept
+{
+    if (useADAA)
+    {
+        // y = (F(u[n]) - F(u[n-1])) / (u[n] - u[n-1]), falls back to the curve at the midpoint
+        // when the difference gets too small. The dry part is delayed by the same half sample.
+        constexpr double tolerance = 1.0e-5;
+
+        auto lastInput = state.lastInput;
+        auto lastAntiderivative = state.lastAntiderivative;
+        auto lastDry = state.lastDry;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto x = input[i];
+            auto u = (double)(drive * x);
+            auto antiderivative = Curve::antiderivative(u);
+            auto difference = u - lastInput;
+
+            auto shaped = std::abs(difference) > tolerance
+                        ? (float)((antiderivative - lastAntiderivative) / difference)
+                        : Curve::processExact((float)(0.5 * (u + lastInput)));
+
+            output[i] = shaped + 0.5f * (x + lastDry);
+
+            lastInput = u;
+            lastAntiderivative = antiderivative;
+            lastDry = x;
+        }
+
+        state.lastInput = lastInput;
+        state.lastAntiderivative = lastAntiderivative;
+        state.lastDry = lastDry;
+        return;
+    }
+
+    if (Curve::isVectorExact || useApproximations)
+    {
+        SimdKernels::get().clip[(int)type](input, output, numSamples, drive);
+    }
+    else
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = Curve::processExact(drive * input[i]) + input[i];
+    }
+
+    // keeps the ADAA history valid if it gets switched on
+    if (numSamples > 0)
+    {
+        state.lastDry = input[numSamples - 1];
+        state.lastInput = (double)(drive * state.lastDry);
+        state.lastAntiderivative = Curve::antiderivative(state.lastInput);
+    }
+}
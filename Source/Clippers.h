@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+    Clippers.h
+    Created: 19 Oct 2026 1:26:08pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DiodeClipper.h"
+
+// Transfer functions for the Clipping stage. Each one is a policy class with
+//  - process<T>(u):    branch free, for float and for juce::dsp::SIMDRegister<float>.
+//                      Exact unless isVectorExact is false, then it's a fast approximation.
+//  - processExact(u):  the reference curve, scalar.
+//  - antiderivative(u): integral of processExact, for antiderivative antialiasing (ADAA).
+// The stage output is curve(drive * x) + x, the curves are bounded to [-1, 1].
+// SimdKernelsX86.h has its own copy of the process<T> curves for AVX2 and AVX-512.
+namespace clippers
+{
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    inline float absolute(float x) noexcept            { return std::abs(x); }
+    inline Vec absolute(Vec x) noexcept                { return Vec::max(x, Vec::expand(0.f) - x); }
+
+    inline float clamp(float x, float lo, float hi) noexcept { return juce::jlimit(lo, hi, x); }
+    inline Vec clamp(Vec x, float lo, float hi) noexcept     { return Vec::min(Vec::max(x, Vec::expand(lo)), Vec::expand(hi)); }
+
+    inline float divide(float a, float b) noexcept     { return a / b; }
+    inline Vec divide(Vec a, Vec b) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        return Vec::fromNative(_mm_div_ps(a.value, b.value));
+       #elif JUCE_USE_ARM_NEON && JUCE_64BIT
+        return Vec::fromNative(vdivq_f32(a.value, b.value));
+       #else
+        for (size_t i = 0; i < Vec::size(); ++i)
+            a.set(i, a.get(i) / b.get(i));
+
+        return a;
+       #endif
+    }
+
+    struct Atan
+    {
+        static constexpr bool isVectorExact = false;
+
+        // u (2/pi + |u|) / (1 + (4/pi)|u| + u^2), within 0.7% of the real curve
+        template <typename T>
+        static T process(T u) noexcept
+        {
+            auto a = absolute(u);
+            return divide(u * (a + 2.f / juce::MathConstants<float>::pi),
+                          u * u + a * (4.f / juce::MathConstants<float>::pi) + 1.f);
+        }
+
+        static float processExact(float u) noexcept
+        {
+            return (2.f / juce::MathConstants<float>::pi) * std::atan(u);
+        }
+
+        static double antiderivative(double u) noexcept
+        {
+            return (2.0 / juce::MathConstants<double>::pi) * (u * std::atan(u) - 0.5 * std::log1p(u * u));
+        }
+    };
+
+    struct Tanh
+    {
+        static constexpr bool isVectorExact = false;
+
+        // same Pade approximant as juce::dsp::FastMathApproximations::tanh, kept inside its valid range
+        template <typename T>
+        static T process(T u) noexcept
+        {
+            auto x = clamp(u, -5.f, 5.f);
+            auto x2 = x * x;
+            auto numerator = x * (x2 * (x2 * (x2 + 378.f) + 17325.f) + 135135.f);
+            auto denominator = x2 * (x2 * (x2 * 28.f + 3150.f) + 62370.f) + 135135.f;
+            return clamp(divide(numerator, denominator), -1.f, 1.f);
+        }
+
+        static float processExact(float u) noexcept
+        {
+            return std::tanh(u);
+        }
+
+        static double antiderivative(double u) noexcept
+        {
+            // log(cosh(u)) without overflowing for large drive
+            auto a = std::abs(u);
+            return a + std::log1p(std::exp(-2.0 * a)) - std::log(2.0);
+        }
+    };
+
+    struct Cubic
+    {
+        static constexpr bool isVectorExact = true;
+
+        template <typename T>
+        static T process(T u) noexcept
+        {
+            auto x = clamp(u, -1.f, 1.f);
+            return x * 1.5f - x * x * x * 0.5f;
+        }
+
+        static float processExact(float u) noexcept { return process(u); }
+
+        static double antiderivative(double u) noexcept
+        {
+            if (std::abs(u) > 1.0)
+                return std::abs(u) - 0.375;
+
+            return 0.75 * u * u - 0.125 * u * u * u * u;
+        }
+    };
+
+    struct Hard
+    {
+        static constexpr bool isVectorExact = true;
+
+        template <typename T>
+        static T process(T u) noexcept
+        {
+            return clamp(u, -1.f, 1.f);
+        }
+
+        static float processExact(float u) noexcept { return process(u); }
+
+        static double antiderivative(double u) noexcept
+        {
+            if (std::abs(u) > 1.0)
+                return std::abs(u) - 0.5;
+
+            return 0.5 * u * u;
+        }
+    };
+
+    // Hard clips the negative half earlier, the DC this adds is removed by LowPass2
+    struct Asymmetric
+    {
+        static constexpr bool isVectorExact = true;
+        static constexpr float negativeLimit = -0.5f;
+
+        template <typename T>
+        static T process(T u) noexcept
+        {
+            return clamp(u, negativeLimit, 1.f);
+        }
+
+        static float processExact(float u) noexcept { return process(u); }
+
+        static double antiderivative(double u) noexcept
+        {
+            if (u > 1.0)
+                return u - 0.5;
+
+            if (u < negativeLimit)
+                return negativeLimit * u - 0.5 * negativeLimit * negativeLimit;
+
+            return 0.5 * u * u;
+        }
+    };
+}
+
+enum class ClipperType
+{
+    Atan,
+    Tanh,
+    Cubic,
+    Hard,
+    Asymmetric,
+    Diode
+};
+
+// The Clipping stage of the chain. The curve is picked once per block and each curve gets
+// its own instantiated loop, so there is no indirect call per sample.
+class ClipperStage
+{
+public:
+    static juce::StringArray getTypeNames();
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset() noexcept;
+
+    void setType(ClipperType newType) noexcept      { type = newType; }
+    void setDrive(float newDrive) noexcept          { drive = newDrive; diode.setDrive(newDrive); }
+
+    // First order ADAA, half a sample of delay. Runs the scalar loop.
+    void setAntiderivativeAntialiasing(bool shouldUseADAA) noexcept  { useADAA = shouldUseADAA; }
+
+    // Lets atan/tanh run the vectorised approximations instead of the exact scalar curves
+    void setUseApproximations(bool shouldApproximate) noexcept       { useApproximations = shouldApproximate; }
+
+    // Extra Newton steps per sample for the Diode type, on top of its solution table
+    void setDiodeNewtonIterations(int numIterations) noexcept        { diode.setNewtonIterations(numIterations); }
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto&& inputBlock = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert(inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert(inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+
+            return;
+        }
+
+        for (size_t ch = 0; ch < outputBlock.getNumChannels(); ++ch)
+            processChannel(inputBlock.getChannelPointer(ch), outputBlock.getChannelPointer(ch),
+                           outputBlock.getNumSamples(), states[juce::jmin(ch, states.size() - 1)]);
+    }
+
+    struct ChannelState
+    {
+        double lastInput { 0 }, lastAntiderivative { 0 };
+        float lastDry { 0 };
+
+        DiodeClipper::ChannelState diode;
+    };
+
+    void processChannel(const float* input, float* output, size_t numSamples, ChannelState& state) noexcept;
+
+private:
+    template <typename Curve>
+    void processWith(const float* input, float* output, size_t numSamples, ChannelState& state) noexcept;
+
+    ClipperType type { ClipperType::Atan };
+    float drive { 1 };
+    bool useADAA { false }, useApproximations { false };
+
+    DiodeClipper diode;
+
+    std::vector<ChannelState> states = std::vector<ChannelState>(1);
+};
@@ -10,33 +10,39 @@
 
 #pragma once
 
+// Parameter IDs, which are also their names. constexpr, so any translation unit can include this.
 class Parameters {
 public:
-	static const char* k_drive;
-    static const char* k_bass;
-    static const char* k_mid;
-    static const char* k_treble;
-    static const char* k_volume;
-    static const char* k_output_level;
-    static const char* k_input_level;
-    static const char* k_low_pass_freq;
-    static const char* k_high_shelf_freq;
-    static const char* k_high_shelf_gain;
-    static const char* k_high_shelf_q;
+    static constexpr const char* k_drive = "Drive";
+    static constexpr const char* k_bass = "Bass";
+    static constexpr const char* k_mid = "Middle";
+    static constexpr const char* k_treble = "Treble";
+    static constexpr const char* k_volume = "Volume";
+    static constexpr const char* k_output_level = "Output Level";
+    static constexpr const char* k_input_level = "Input Level";
+    static constexpr const char* k_low_pass_freq = "Post dist low pass frequency";
+    static constexpr const char* k_high_shelf_freq = "Post dist high shelf frequency";
+    static constexpr const char* k_high_shelf_gain = "Post dist high shelf gain";
+    static constexpr const char* k_high_shelf_q = "Post dist high shelf q";
+    static constexpr const char* k_clipper_type = "Clipper";
+    static constexpr const char* k_clipper_adaa = "Clipper antialiasing";
+    static constexpr const char* k_gain_stages = "Gain stages";
+    static constexpr const char* k_stage_drive = "Stage drive";
+    static constexpr const char* k_threaded_cabinet = "Threaded cabinet";
+    static constexpr const char* k_light_cabinet = "Light cabinet";
+    static constexpr const char* k_quality = "Quality";
+    static constexpr const char* k_mic1_level = "Mic 1 level";
+    static constexpr const char* k_mic1_invert = "Mic 1 invert";
+    static constexpr const char* k_mic1_offset = "Mic 1 offset";
+    static constexpr const char* k_mic2_level = "Mic 2 level";
+    static constexpr const char* k_mic2_invert = "Mic 2 invert";
+    static constexpr const char* k_mic2_offset = "Mic 2 offset";
+    static constexpr const char* k_bypass = "Bypass";
+    static constexpr const char* k_input_meter = "Input meter";
+    static constexpr const char* k_output_meter = "Output meter";
+    static constexpr const char* k_clipping_meter = "Clipping meter";
 };
 
-const char* Parameters::k_drive = "Drive";
-const char* Parameters::k_bass = "Bass";
-const char* Parameters::k_mid = "Middle";
-const char* Parameters::k_treble = "Treble";
-const char* Parameters::k_volume = "Volume";
-const char* Parameters::k_output_level = "Output Level";
-const char* Parameters::k_input_level = "Input Level";
-const char* Parameters::k_low_pass_freq = "Post dist low pass frequency";
-const char* Parameters::k_high_shelf_freq = "Post dist high shelf frequency";
-const char* Parameters::k_high_shelf_gain = "Post dist high shelf gain";
-const char* Parameters::k_high_shelf_q = "Post dist high shelf q";
-
 // Tone Stack Values. Reference https://ccrma.stanford.edu/~dtyeh/papers/yeh06_dafx.pdf
 // C1 = 0.25nF
 // C2 = C3 = 20nF
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    DeadlineMonitor.cpp
+    Created: 23 Oct 2026 2:41:36pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "DeadlineMonitor.h"
+
+namespace
+{
+    std::atomic<int> numInstancesCreated { 0 };
+
+    // relaxed loads and stores, the audio thread is the only writer
+    template <typename T>
+    void increment(std::atomic<T>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+double DeadlineMonitor::Stats::percentile(double p) const noexcept
+{
+    auto target = (juce::uint64)std::ceil(p * (double)numCallbacks);
+    juce::uint64 count = 0;
+
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        count += histogram[(size_t)i];
+
+        if (count >= target && count > 0)
+            return i == numBuckets - 1 ? worstLoad : juce::jmin(worstLoad, (i + 1) * bucketPercent / 100.0);
+    }
+
+    return 0;
+}
+
+DeadlineMonitor::DeadlineMonitor()
+    : instanceNumber(++numInstancesCreated)
+{
+    backgroundThread->addTimeSliceClient(this);
+}
+
+DeadlineMonitor::~DeadlineMonitor()
+{
+    backgroundThread->removeTimeSliceClient(this);
+}
+
+void DeadlineMonitor::prepare(double newSampleRate, int newMaximumBlockSize) noexcept
+{
+    sampleRate.store(newSampleRate);
+    maximumBlockSize.store(newMaximumBlockSize);
+}
+
+void DeadlineMonitor::addCallback(juce::int64 ticks, int numSamples) noexcept
+{
+    auto rate = sampleRate.load(std::memory_order_relaxed);
+
+    if (rate <= 0)
+        return;
+
+    if (resetPending.exchange(false))
+    {
+        for (auto& bucket : histogram)
+            bucket.store(0, std::memory_order_relaxed);
+
+        numCallbacks.store(0, std::memory_order_relaxed);
+        numNearMisses.store(0, std::memory_order_relaxed);
+        numOverruns.store(0, std::memory_order_relaxed);
+        worstLoad.store(0, std::memory_order_relaxed);
+        worstBlockSize.store(0, std::memory_order_relaxed);
+    }
+
+    auto load = (double)ticks * secondsPerTick * rate / numSamples;
+    auto bucket = juce::jlimit(0, numBuckets - 1, (int)(load * 100.0 / bucketPercent));
+
+    increment(histogram[(size_t)bucket]);
+
+    if (load > 1.0)
+        increment(numOverruns);
+    else if (load >= nearMissLoad)
+        increment(numNearMisses);
+
+    if (load > worstLoad.load(std::memory_order_relaxed))
+    {
+        worstLoad.store(load, std::memory_order_relaxed);
+        worstBlockSize.store(numSamples, std::memory_order_relaxed);
+    }
+
+    // last, so a reader that sees the count sees what was counted
+    numCallbacks.store(numCallbacks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+DeadlineMonitor::Stats DeadlineMonitor::getStats() const noexcept
+{
+    Stats stats;
+
+    stats.numCallbacks = numCallbacks.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        stats.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+
+    stats.numNearMisses = numNearMisses.load(std::memory_order_relaxed);
+    stats.numOverruns = numOverruns.load(std::memory_order_relaxed);
+    stats.worstLoad = worstLoad.load(std::memory_order_relaxed);
+    stats.worstBlockSize = worstBlockSize.load(std::memory_order_relaxed);
+    stats.sampleRate = sampleRate.load();
+    stats.maximumBlockSize = maximumBlockSize.load();
+
+    return stats;
+}
+
+int DeadlineMonitor::useTimeSlice()
+{
+    auto interval = logIntervalMs.load();
+
+    if (interval <= 0)
+        return 500;
+
+    auto now = juce::Time::getMillisecondCounter();
+
+    if (now - lastLogTime < (juce::uint32)interval)
+        return (int)juce::jmin((juce::uint32)500, (juce::uint32)interval - (now - lastLogTime));
+
+    lastLogTime = now;
+
+    auto stats = getStats();
+
+    // quiet while the instance isn't processing, and after a reset until it is again
+    if (stats.numCallbacks == loggedCallbacks || stats.numCallbacks == 0)
+        return juce::jmin(500, interval);
+
+    loggedCallbacks = stats.numCallbacks;
+
+    auto percent = [] (double load) { return juce::String(juce::roundToInt(load * 100.0)) + "%"; };
+
+    juce::Logger::writeToLog("SoftClippingPreamp #" + juce::String(instanceNumber) + ", "
+                             + juce::String(juce::roundToInt(stats.sampleRate)) + " Hz, " + juce::String(stats.maximumBlockSize) + " samples: "
+                             + juce::String(stats.numCallbacks) + " callbacks, p50 " + percent(stats.percentile(0.5))
+                             + ", p99 " + percent(stats.percentile(0.99)) + ", p99.9 " + percent(stats.percentile(0.999))
+                             + ", worst " + percent(stats.worstLoad) + " on " + juce::String(stats.worstBlockSize) + " samples, "
+                             + juce::String(stats.numNearMisses) + " near misses, " + juce::String(stats.numOverruns) + " overruns");
+
+    return juce::jmin(500, interval);
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    DeadlineMonitor.h
+    Created: 23 Oct 2026 2:41:36pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BackgroundThread.h"
+
+// How long one instance's processBlock takes against the time the block plays for. The audio thread
+// only reads the clock twice and bumps a few atomics, everything else reads them from other threads.
+//
+// Loads go into a histogram of 10% buckets, the last one for everything over twice the budget.
+// With a log interval set, a line with the instance's numbers goes to juce::Logger from the shared
+// background thread, for the intervals in which it ran.
+class DeadlineMonitor : private juce::TimeSliceClient
+{
+public:
+    static constexpr int numBuckets = 21;
+    static constexpr int bucketPercent = 10;
+
+    // A callback over this much of its budget counts as a near miss
+    static constexpr double nearMissLoad = 0.8;
+
+    struct Stats
+    {
+        std::array<juce::uint64, numBuckets> histogram {};
+        juce::uint64 numCallbacks { 0 }, numNearMisses { 0 }, numOverruns { 0 };
+        double worstLoad { 0 };
+        int worstBlockSize { 0 };
+        double sampleRate { 0 };
+        int maximumBlockSize { 0 };
+
+        // The upper edge of the bucket the given fraction of callbacks falls in, as a load, at most the worst
+        double percentile(double p) const noexcept;
+    };
+
+    DeadlineMonitor();
+    ~DeadlineMonitor() override;
+
+    // Times the enclosing scope as one callback of numSamples
+    class ScopedCallback
+    {
+    public:
+        ScopedCallback(DeadlineMonitor& m, int samples, bool isRealtime) noexcept
+            : monitor(isRealtime && samples > 0 ? &m : nullptr), numSamples(samples),
+              start(monitor != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedCallback()
+        {
+            if (monitor != nullptr)
+                monitor->addCallback(juce::Time::getHighResolutionTicks() - start, numSamples);
+        }
+
+    private:
+        DeadlineMonitor* monitor;
+        int numSamples;
+        juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedCallback)
+    };
+
+    // Before processing starts, from prepareToPlay
+    void prepare(double sampleRate, int maximumBlockSize) noexcept;
+
+    // Any thread. reset() takes effect on the next callback.
+    Stats getStats() const noexcept;
+    void reset() noexcept                                   { resetPending.store(true); }
+
+    // Any thread, 0 stops the log
+    void setLogInterval(double seconds) noexcept            { logIntervalMs.store(juce::roundToInt(seconds * 1000.0)); }
+
+    // Shows up in the log lines to tell instances apart
+    int getInstanceNumber() const noexcept                  { return instanceNumber; }
+
+private:
+    void addCallback(juce::int64 ticks, int numSamples) noexcept;
+    int useTimeSlice() override;
+
+    // Written by the audio thread only, so increments don't need read-modify-write atomics
+    std::array<std::atomic<juce::uint64>, numBuckets> histogram {};
+    std::atomic<juce::uint64> numCallbacks { 0 }, numNearMisses { 0 }, numOverruns { 0 };
+    std::atomic<double> worstLoad { 0 };
+    std::atomic<int> worstBlockSize { 0 };
+    std::atomic<bool> resetPending { false };
+
+    std::atomic<double> sampleRate { 0 };
+    std::atomic<int> maximumBlockSize { 0 };
+    double secondsPerTick { 1.0 / (double)juce::Time::getHighResolutionTicksPerSecond() };
+
+    // Background thread
+    std::atomic<int> logIntervalMs { 0 };
+    juce::uint64 loggedCallbacks { 0 };
+    juce::uint32 lastLogTime { 0 };
+
+    const int instanceNumber;
+
+    juce::SharedResourcePointer<BackgroundThread> backgroundThread;
+
+    JUCE_DECLARE_NON_COPYABLE (DeadlineMonitor)
+};
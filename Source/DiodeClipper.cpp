@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    DiodeClipper.cpp
+    Created: 19 Oct 2026 3:12:54pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "DiodeClipper.h"
+
+void DiodeClipper::prepare(double sampleRate)
+{
+    table = getTable(sampleRate);
+}
+
+std::shared_ptr<const DiodeClipper::Table> DiodeClipper::getTable(double sampleRate)
+{
+    static juce::CriticalSection cacheLock;
+    static std::vector<std::weak_ptr<const Table>> cache;
+
+    const juce::ScopedLock sl(cacheLock);
+
+    for (auto& entry : cache)
+        if (auto existing = entry.lock())
+            if (existing->sampleRate == sampleRate)
+                return existing;
+
+    auto newTable = std::make_shared<Table>();
+
+    auto T = 1.0 / sampleRate;
+    newTable->sampleRate = sampleRate;
+    newTable->inputCoefficient = T / (2.0 * R * C);
+    newTable->k1 = 1.0 + newTable->inputCoefficient;
+    newTable->k2 = T * Is / C;
+    newTable->qMax = tableRange;
+    newTable->indexScale = (float)(tableSize - 1) / (2.f * tableRange);
+
+    newTable->voltages.resize(tableSize);
+
+    for (int i = 0; i < tableSize; ++i)
+    {
+        auto q = -tableRange + 2.0 * tableRange * i / (tableSize - 1);
+        newTable->voltages[(size_t)i] = (float)solve(q, newTable->k1, newTable->k2);
+    }
+
+    cache.erase(std::remove_if(cache.begin(), cache.end(), [] (auto& e) { return e.expired(); }), cache.end());
+    cache.push_back(newTable);
+
+    return newTable;
+}
+
+double DiodeClipper::solve(double q, double k1, double k2) noexcept
+{
+    // V has the sign of q and |V| is bounded by both the resistive and the diode term alone,
+    // which gives a bracket for a safeguarded Newton iteration
+    auto a = std::abs(q);
+    double lo = 0, hi = juce::jmin(a / k1, nVt * std::asinh(a / k2));
+    double v = hi;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto h = k1 * v + k2 * std::sinh(v / nVt) - a;
+
+        if (h > 0)
+            hi = v;
+        else
+            lo = v;
+
+        auto next = v - h / (k1 + (k2 / nVt) * std::cosh(v / nVt));
+
+        if (next < lo || next > hi)
+            next = 0.5 * (lo + hi);
+
+        if (std::abs(next - v) < 1.0e-14)
+        {
+            v = next;
+            break;
+        }
+
+        v = next;
+    }
+
+    return q < 0 ? -v : v;
+}
+
+float DiodeClipper::lookup(float q) const noexcept
+{
+    auto position = (q + table->qMax) * table->indexScale;
+    auto index = (int)position;
+    auto fraction = position - (float)index;
+
+    auto* v = table->voltages.data();
+    return v[index] + (v[index + 1] - v[index]) * fraction;
+}
+
+float DiodeClipper::refine(float q, float estimate, int numIterations) const noexcept
+{
+    auto k1 = table->k1, k2 = table->k2;
+    auto v = (double)estimate;
+
+    for (int i = 0; i < numIterations; ++i)
+    {
+        // one exp for both sinh and cosh
+        auto e = std::exp(v / nVt);
+        auto s = 0.5 * (e - 1.0 / e);
+        auto c = 0.5 * (e + 1.0 / e);
+        v -= (k1 * v + k2 * s - q) / (k1 + (k2 / nVt) * c);
+    }
+
+    return (float)v;
+}
+
+void DiodeClipper::processChannel(const float* input, float* output, size_t numSamples, ChannelState& state) const noexcept
+{
+    jassert(table != nullptr);
+
+    auto p = state.p;
+    auto inputGain = (float)table->inputCoefficient * drive * inputScale;
+    auto qLimit = table->qMax * 0.999f;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto q = p + inputGain * input[i];
+        float v;
+
+        if (std::abs(q) < qLimit)
+        {
+            v = lookup(q);
+
+            if (newtonIterations > 0)
+                v = refine(q, v, newtonIterations);
+        }
+        else
+        {
+            // past the table the diode term dominates, its inverse is a good starting point
+            auto estimate = (float)(nVt * std::asinh((double)std::abs(q) / table->k2));
+            v = refine(q, q < 0 ? -estimate : estimate, juce::jmax(3, newtonIterations));
+        }
+
+        p = 2.f * v - p;
+        output[i] = v * outputScale + input[i];
+    }
+
+    state.p = p;
+}
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    DiodeClipper.h
+    Created: 19 Oct 2026 3:12:54pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// RC low pass into a pair of anti-parallel 1N4148s, the circuit the atan curve approximates:
+//
+//     dV/dt = (Vin - V) / RC - (2 Is / C) sinh(V / nVt)
+//
+// Discretised with the trapezoidal rule every sample solves
+//
+//     k1 V + k2 sinh(V / nVt) = q,     q = p + (T / 2RC) Vin,     k1 = 1 + T / 2RC,  k2 = T Is / C
+//
+// where p = V[n-1] + T/2 f(V[n-1], Vin[n-1]) is the only state. The state and the input fold into q,
+// so the solution table is one dimensional. V(q) is tabulated once per sample rate and looked up with
+// linear interpolation; q outside the table, or a request for extra accuracy, goes through Newton
+// iterations warm-started from the table. The next state is 2V - p, so the loop has no transcendentals.
+class DiodeClipper
+{
+public:
+    struct Table
+    {
+        double sampleRate { 0 };
+        double k1 { 1 }, k2 { 0 }, inputCoefficient { 0 };
+        float qMax { 0 }, indexScale { 0 };
+        std::vector<float> voltages;
+    };
+
+    struct ChannelState
+    {
+        float p { 0 };
+    };
+
+    static constexpr double R = 2.2e3;
+    static constexpr double C = 10.0e-9;
+    static constexpr double Is = 2.52e-9;
+    static constexpr double nVt = 1.752 * 25.85e-3;
+
+    static constexpr int tableSize = 4096;
+    static constexpr float tableRange = 48.f;   // volts of q either side of 0
+
+    // Drive maps the normalised input to volts, the diode voltage is scaled back to roughly +-1
+    static constexpr float inputScale = 0.1f;
+    static constexpr float outputScale = 1.f / 0.7f;
+
+    // Tables are shared by every instance running at the same rate
+    void prepare(double sampleRate);
+
+    void setDrive(float newDrive) noexcept                  { drive = newDrive; }
+
+    // Newton steps on top of the table lookup, for every sample. 0 relies on the table alone.
+    void setNewtonIterations(int numIterations) noexcept    { newtonIterations = numIterations; }
+
+    // output = normalised diode voltage + dry input, like the static curves
+    void processChannel(const float* input, float* output, size_t numSamples, ChannelState& state) const noexcept;
+
+    // Reference solution of the implicit equation, to double precision
+    static double solve(double q, double k1, double k2) noexcept;
+
+private:
+    static std::shared_ptr<const Table> getTable(double sampleRate);
+
+    float lookup(float q) const noexcept;
+    float refine(float q, float estimate, int numIterations) const noexcept;
+
+    std::shared_ptr<const Table> table;
+    float drive { 1 };
+    int newtonIterations { 0 };
+};
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    DspState.h
+    Created: 19 Oct 2026 10:11:47am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BackgroundThread.h"
+
+struct Settings
+{
+    float low_gain { 0 }, middle_gain { 0 }, treble_gain { 0 };
+    float low_pass_freq { 0 }, high_shelf_freq { 0 }, high_shelf_gain { 0 }, high_shelf_q { 0 };
+    float drive { 0 }, volume { 0 };
+    float input_level { 0 }, output_level { 0 };
+    int clipper_type { 0 };
+    bool clipper_adaa { false };
+    int gain_stages { 1 };
+    float stage_drive { 0 };
+    bool threaded_cabinet { false };
+    bool light_cabinet { false };
+    int quality { 1 };
+    float mic1_level { 0 }, mic2_level { -60 };
+    bool mic1_invert { false }, mic2_invert { false };
+    float mic1_offset { 0 }, mic2_offset { 0 };
+
+    bool operator== (const Settings& other) const
+    {
+        return std::tie(low_gain, middle_gain, treble_gain, low_pass_freq, high_shelf_freq, high_shelf_gain, high_shelf_q,
+                        drive, volume, input_level, output_level, clipper_type, clipper_adaa, gain_stages, stage_drive, threaded_cabinet, light_cabinet,
+                        quality, mic1_level, mic1_invert, mic1_offset, mic2_level, mic2_invert, mic2_offset)
+            == std::tie(other.low_gain, other.middle_gain, other.treble_gain, other.low_pass_freq, other.high_shelf_freq,
+                        other.high_shelf_gain, other.high_shelf_q, other.drive, other.volume, other.input_level, other.output_level,
+                        other.clipper_type, other.clipper_adaa, other.gain_stages, other.stage_drive,
+                        other.threaded_cabinet, other.light_cabinet, other.quality, other.mic1_level, other.mic1_invert, other.mic1_offset,
+                        other.mic2_level, other.mic2_invert, other.mic2_offset);
+    }
+
+    bool operator!= (const Settings& other) const { return ! (*this == other); }
+};
+
+// A complete, immutable DSP configuration. It is designed off the audio thread and the
+// audio thread only ever copies values out of it.
+struct DspSnapshot
+{
+    using CoefficientsPtr = juce::dsp::IIR::Coefficients<float>::Ptr;
+
+    Settings settings;
+    double sampleRate { 0 };
+    juce::uint64 generation { 0 };
+
+    CoefficientsPtr lowPass, lowPass2, highShelf;
+    juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> toneStack;
+};
+
+// Single writer (message thread) / single reader (audio thread) hand-over of immutable objects
+// such as DspSnapshots. ObjectType needs a juce::uint64 generation member, which publish() fills in.
+//
+// publish() swaps the new object in with one atomic exchange. The reader brackets its access
+// with beginRead()/endRead(), which only bump an epoch counter, so it never waits. A replaced
+// object is kept alive until the reader has left the read it might have started with it, and
+// is then deleted on the shared background thread.
+template <typename ObjectType>
+class SnapshotPublisher : private juce::TimeSliceClient
+{
+public:
+    SnapshotPublisher()
+    {
+        backgroundThread->addTimeSliceClient(this);
+    }
+
+    ~SnapshotPublisher() override
+    {
+        backgroundThread->removeTimeSliceClient(this);
+
+        // The owner is being destroyed, so nobody is reading any more.
+        for (auto& r : retired)
+            delete r.object;
+
+        delete current.exchange(nullptr);
+    }
+
+    void publish(std::unique_ptr<ObjectType> object)
+    {
+        jassert(object != nullptr);
+
+        {
+            const juce::ScopedLock sl(retiredLock);
+            object->generation = nextGeneration++;
+        }
+
+        auto* old = current.exchange(object.release());
+
+        if (old != nullptr)
+        {
+            const juce::ScopedLock sl(retiredLock);
+            retired.add({ old, readerEpoch.load() });
+        }
+    }
+
+    // Audio thread only. The returned object (possibly nullptr) is valid until endRead().
+    const ObjectType* beginRead() noexcept
+    {
+        readerEpoch.fetch_add(1); // odd: a read is in progress
+        return current.load();
+    }
+
+    void endRead() noexcept
+    {
+        readerEpoch.fetch_add(1);
+    }
+
+private:
+    struct Retired
+    {
+        ObjectType* object;
+        juce::uint64 epoch;
+    };
+
+    bool canReclaim(const Retired& r) const noexcept
+    {
+        // If the reader was idle when the object got replaced, it can only see the new one.
+        // Otherwise it must have moved past the read that was running at that moment.
+        return (r.epoch & 1) == 0 || readerEpoch.load() != r.epoch;
+    }
+
+    int useTimeSlice() override
+    {
+        juce::Array<ObjectType*> toDelete;
+
+        {
+            const juce::ScopedLock sl(retiredLock);
+
+            for (int i = retired.size(); --i >= 0;)
+            {
+                if (canReclaim(retired.getReference(i)))
+                {
+                    toDelete.add(retired.getReference(i).object);
+                    retired.remove(i);
+                }
+            }
+        }
+
+        for (auto* o : toDelete)
+            delete o;
+
+        const juce::ScopedLock sl(retiredLock);
+        return retired.isEmpty() ? 200 : 20;
+    }
+
+    std::atomic<ObjectType*> current { nullptr };
+    std::atomic<juce::uint64> readerEpoch { 0 };
+    juce::uint64 nextGeneration { 1 };
+
+    juce::CriticalSection retiredLock;
+    juce::Array<Retired> retired;
+
+    juce::SharedResourcePointer<BackgroundThread> backgroundThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SnapshotPublisher)
+};
+
+using DspStatePublisher = SnapshotPublisher<DspSnapshot>;
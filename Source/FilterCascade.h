@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    FilterCascade.h
+    Created: 22 Oct 2026 9:41:17am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One section's design by value: b0..b2 and a1, a2, divided by a0 the way juce::dsp::IIR::Coefficients
+// does it. It needs no heap, so the audio thread can redesign into one while a parameter glides.
+struct SectionDesign
+{
+    float b[3] { 1.f, 0.f, 0.f };
+    float a[3] { 1.f, 0.f, 0.f };
+    int order { 2 };
+
+    static SectionDesign firstOrder(float b0, float b1, float a0, float a1) noexcept
+    {
+        auto a0Inv = a0 != 0.f ? 1.f / a0 : 0.f;
+        return { { b0 * a0Inv, b1 * a0Inv, 0.f }, { 1.f, a1 * a0Inv, 0.f }, 1 };
+    }
+
+    static SectionDesign secondOrder(float b0, float b1, float b2, float a0, float a1, float a2) noexcept
+    {
+        auto a0Inv = a0 != 0.f ? 1.f / a0 : 0.f;
+        return { { b0 * a0Inv, b1 * a0Inv, b2 * a0Inv }, { 1.f, a1 * a0Inv, a2 * a0Inv }, 2 };
+    }
+
+    // Allocates, for the editor and the snapshots
+    juce::dsp::IIR::Coefficients<float>::Ptr toCoefficients() const
+    {
+        if (order == 1)
+            return new juce::dsp::IIR::Coefficients<float>(b[0], b[1], 1.f, a[1]);
+
+        return new juce::dsp::IIR::Coefficients<float>(b[0], b[1], b[2], 1.f, a[1], a[2]);
+    }
+};
+
+// A run of IIR sections, up to second order each, for one channel. Coefficients and state live inside
+// the object, a cache line per section, so the process chain holds them inline. juce::dsp::IIR::Filter
+// reaches its coefficients through a reference counted heap object instead.
+//
+// Every section runs as a biquad in transposed direct form II. First order sections have their unused
+// coefficients at zero, which leaves the unused state at zero too. Higher orders get factored into
+// sections before they get here, see makeToneStackFilter.
+template <size_t numSections>
+class FilterCascade
+{
+public:
+    static constexpr int maxOrder = 2;
+
+    // Copies a design in, realtime safe. Sections start out passing the signal through.
+    void setCoefficients(size_t index, const juce::dsp::IIR::Coefficients<float>& coefficients) noexcept
+    {
+        auto& section = sections[index];
+        auto order = (int)(coefficients.coefficients.size() - 1) / 2;
+        jassert(order <= maxOrder);
+        order = juce::jmin(maxOrder, order);
+        auto* c = coefficients.coefficients.begin();
+
+        // juce keeps b0..bN, a1..aN, already divided by a0
+        for (int i = 0; i <= maxOrder; ++i)
+        {
+            section.b[i] = i <= order ? c[i] : 0.f;
+            section.a[i] = i > 0 && i <= order ? c[order + i] : 0.f;
+        }
+    }
+
+    void setCoefficients(size_t index, const SectionDesign& design) noexcept
+    {
+        auto& section = sections[index];
+
+        for (int i = 0; i <= maxOrder; ++i)
+        {
+            section.b[i] = design.b[i];
+            section.a[i] = i > 0 ? design.a[i] : 0.f;
+        }
+    }
+
+    void setBypassed(size_t index, bool shouldBeBypassed) noexcept  { sections[index].bypassed = shouldBeBypassed; }
+    bool isBypassed(size_t index) const noexcept                    { return sections[index].bypassed; }
+
+    void prepare(const juce::dsp::ProcessSpec&) noexcept            { reset(); }
+
+    void reset() noexcept
+    {
+        for (size_t i = 0; i < numSections; ++i)
+            reset(i);
+    }
+
+    void reset(size_t index) noexcept
+    {
+        std::fill(std::begin(sections[index].state), std::end(sections[index].state), 0.f);
+    }
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto&& inputBlock = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert(inputBlock.getNumChannels() == 1);
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom(inputBlock);
+
+        if (context.isBypassed)
+            return;
+
+        for (auto& section : sections)
+            if (! section.bypassed)
+                processSection(section, outputBlock.getChannelPointer(0), outputBlock.getNumSamples());
+    }
+
+    // The whole cascade for processFused(): coefficients and state copied into locals for one block,
+    // the state written back by finish(). Bypassed sections pass through and keep their state.
+    struct Kernel
+    {
+        explicit Kernel(FilterCascade& cascade) noexcept : owner(cascade)
+        {
+            for (size_t n = 0; n < numSections; ++n)
+            {
+                auto& section = owner.sections[n];
+                auto active = ! section.bypassed;
+
+                for (int i = 0; i <= maxOrder; ++i)
+                {
+                    b[n][i] = active ? section.b[i] : (i == 0 ? 1.f : 0.f);
+                    a[n][i] = active ? section.a[i] : 0.f;
+                }
+
+                for (int i = 0; i < maxOrder; ++i)
+                    s[n][i] = active ? section.state[i] : 0.f;
+            }
+        }
+
+        float processSample(float x) noexcept
+        {
+            for (size_t n = 0; n < numSections; ++n)
+            {
+                auto y = b[n][0] * x + s[n][0];
+
+                s[n][0] = b[n][1] * x - a[n][1] * y + s[n][1];
+                s[n][1] = b[n][2] * x - a[n][2] * y;
+
+                x = y;
+            }
+
+            return x;
+        }
+
+        void finish() noexcept
+        {
+            for (size_t n = 0; n < numSections; ++n)
+            {
+                if (owner.sections[n].bypassed)
+                    continue;
+
+                for (int i = 0; i < maxOrder; ++i)
+                {
+                    juce::dsp::util::snapToZero(s[n][i]);
+                    owner.sections[n].state[i] = s[n][i];
+                }
+            }
+        }
+
+        FilterCascade& owner;
+        float b[numSections][maxOrder + 1], a[numSections][maxOrder + 1], s[numSections][maxOrder];
+    };
+
+private:
+    struct alignas(64) Section
+    {
+        float b[maxOrder + 1] { 1.f, 0.f, 0.f };
+        float a[maxOrder + 1] { 0.f, 0.f, 0.f };
+        float state[maxOrder] { 0.f, 0.f };
+        bool bypassed { false };
+    };
+
+    static void processSection(Section& section, float* data, size_t numSamples) noexcept
+    {
+        auto b0 = section.b[0], b1 = section.b[1], b2 = section.b[2];
+        auto a1 = section.a[1], a2 = section.a[2];
+        auto s0 = section.state[0], s1 = section.state[1];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto x = data[i];
+            auto y = b0 * x + s0;
+
+            s0 = b1 * x - a1 * y + s1;
+            s1 = b2 * x - a2 * y;
+
+            data[i] = y;
+        }
+
+        juce::dsp::util::snapToZero(s0);
+        juce::dsp::util::snapToZero(s1);
+
+        section.state[0] = s0;
+        section.state[1] = s1;
+    }
+
+    std::array<Section, numSections> sections;
+};
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    FusedKernel.h
+    Created: 22 Oct 2026 1:26:50pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterCascade.h"
+#include "SimdKernels.h"
+#include "LevelMeter.h"
+
+// Per sample views of the chain's stages, for processFused(). A kernel takes what it needs from its
+// stage when it is made, processes one sample at a time and writes its state back in finish().
+struct GainKernel
+{
+    explicit GainKernel(juce::dsp::Gain<float>& g) noexcept
+        : gain(g), value(g.getGainLinear()), smoothing(g.isSmoothing())
+    {
+    }
+
+    float processSample(float x) noexcept   { return smoothing ? gain.processSample(x) : x * value; }
+    void finish() noexcept {}
+
+    juce::dsp::Gain<float>& gain;
+    float value;
+    bool smoothing;
+};
+
+inline GainKernel makeKernel(juce::dsp::Gain<float>& gain) noexcept
+{
+    return GainKernel(gain);
+}
+
+template <size_t numSections>
+typename FilterCascade<numSections>::Kernel makeKernel(FilterCascade<numSections>& cascade) noexcept
+{
+    return typename FilterCascade<numSections>::Kernel(cascade);
+}
+
+// Measures the samples going past it and leaves them as they are. Samples above threshold count
+// towards aboveKnee with a compare, not a branch.
+struct MeterTap
+{
+    LevelSums& sums;
+    float threshold { std::numeric_limits<float>::max() };
+};
+
+struct MeterKernel
+{
+    explicit MeterKernel(MeterTap& t) noexcept
+        : tap(t), threshold(t.threshold), peak(t.sums.levels.peak),
+          sumOfSquares(t.sums.levels.sumOfSquares), aboveKnee(t.sums.aboveKnee)
+    {
+    }
+
+    float processSample(float x) noexcept
+    {
+        auto magnitude = std::abs(x);
+        peak = juce::jmax(peak, magnitude);
+        sumOfSquares += x * x;
+        aboveKnee += (float)(magnitude > threshold);
+        return x;
+    }
+
+    void finish() noexcept
+    {
+        tap.sums.levels.peak = peak;
+        tap.sums.levels.sumOfSquares = sumOfSquares;
+        tap.sums.aboveKnee = aboveKnee;
+    }
+
+    MeterTap& tap;
+    float threshold, peak, sumOfSquares, aboveKnee;
+};
+
+inline MeterKernel makeKernel(MeterTap& tap) noexcept
+{
+    return MeterKernel(tap);
+}
+
+// Carries each sample through all the stages, in the order given, in one loop over the block.
+// It matches running the stages' process() one after the other on a single channel.
+template <typename... Stages>
+void processFused(float* data, size_t numSamples, Stages&... stages) noexcept
+{
+    auto kernels = std::make_tuple(makeKernel(stages)...);
+
+    std::apply([data, numSamples] (auto&... kernel)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto x = data[i];
+            ((x = kernel.processSample(x)), ...);
+            data[i] = x;
+        }
+
+        (kernel.finish(), ...);
+    }, kernels);
+}
+
+// The four filter sections and a gain as processFused would run them, measuring what goes in. With
+// the gain holding still the dispatched kernel takes the block, which may run the sections side by side.
+inline void processFusedCascade(float* data, size_t numSamples, FilterCascade<4>& cascade, juce::dsp::Gain<float>& gain,
+                                LevelSums& input) noexcept
+{
+    if (gain.isSmoothing())
+    {
+        MeterTap meter { input };
+        processFused(data, numSamples, meter, cascade, gain);
+        return;
+    }
+
+    FilterCascade<4>::Kernel kernel(cascade);
+    SimdKernels::get().cascade(data, numSamples, kernel.b, kernel.a, kernel.s, gain.getGainLinear(), input.levels);
+    kernel.finish();
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    LevelMeter.cpp
+    Created: 29 Oct 2026 10:17:04am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "LevelMeter.h"
+
+void LevelMeter::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    heldPeak = meanSquare = meanActivity = 0;
+
+    peak.store(0, std::memory_order_relaxed);
+    rms.store(0, std::memory_order_relaxed);
+    activity.store(0, std::memory_order_relaxed);
+}
+
+void LevelMeter::push(const LevelSums& sums, int blockLength) noexcept
+{
+    auto seconds = blockLength / sampleRate;
+    auto fall = (float)std::pow(10.0, -peakFallDecibelsPerSecond * seconds / 20.0);
+    auto coefficient = (float)(1.0 - std::exp(-seconds / averageSeconds));
+
+    auto count = (float)juce::jmax((size_t)1, sums.numSamples);
+
+    heldPeak = juce::jmax(sums.levels.peak, heldPeak * fall);
+    meanSquare += (sums.levels.sumOfSquares / count - meanSquare) * coefficient;
+    meanActivity += (sums.aboveKnee / count - meanActivity) * coefficient;
+
+    // settled on silence, rather than decaying into denormals
+    if (meanSquare < 1.0e-12f)
+        meanSquare = 0;
+
+    if (meanActivity < 1.0e-6f)
+        meanActivity = 0;
+
+    if (heldPeak < 1.0e-6f)
+        heldPeak = 0;
+
+    peak.store(heldPeak, std::memory_order_relaxed);
+    rms.store(std::sqrt(meanSquare), std::memory_order_relaxed);
+    activity.store(meanActivity, std::memory_order_relaxed);
+}
+
+MeterParameter::MeterParameter(const juce::String& id, const juce::String& label, Category category,
+                               juce::NormalisableRange<float> newRange, std::function<float()> newReading)
+    : juce::AudioProcessorParameterWithID(id, id, label, category),
+      range(std::move(newRange)),
+      reading(std::move(newReading))
+{
+    // about the rate the editor reads the meters at
+    startTimerHz(30);
+}
+
+MeterParameter::~MeterParameter()
+{
+    stopTimer();
+}
+
+float MeterParameter::getReading() const
+{
+    return range.getRange().clipValue(reading());
+}
+
+float MeterParameter::getValue() const
+{
+    return range.convertTo0to1(getReading());
+}
+
+juce::String MeterParameter::getText(float value, int maximumLength) const
+{
+    return juce::String(range.convertFrom0to1(value), 1).substring(0, maximumLength);
+}
+
+float MeterParameter::getValueForText(const juce::String& text) const
+{
+    return range.convertTo0to1(range.getRange().clipValue(text.getFloatValue()));
+}
+
+void MeterParameter::timerCallback()
+{
+    auto value = getValue();
+
+    // hosts only hear about meters that moved
+    if (value != lastSent)
+    {
+        lastSent = value;
+        sendValueChangedMessageToListeners(value);
+    }
+}
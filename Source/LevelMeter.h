@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    LevelMeter.h
+    Created: 29 Oct 2026 10:17:04am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SimdKernels.h"
+
+// What the passes of a block measured at one point of the chain, over every channel that ran.
+// aboveKnee counts the samples past the clipper's knee, only the point before the clipper has one.
+struct LevelSums
+{
+    SimdKernels::Levels levels;
+    float aboveKnee { 0 };
+    size_t numSamples { 0 };
+
+    void add(const LevelSums& other) noexcept
+    {
+        levels.peak = juce::jmax(levels.peak, other.levels.peak);
+        levels.sumOfSquares += other.levels.sumOfSquares;
+        aboveKnee += other.aboveKnee;
+        numSamples += other.numSamples;
+    }
+};
+
+// Peak, RMS and clipper activity at one point of the chain. The audio thread pushes a block's sums
+// once per block, which move the ballistics and store the readings in atomics; the editor and the
+// host's meters read those from any thread.
+//
+// The peak holds the largest sample and falls at peakFallDecibelsPerSecond. RMS and activity are
+// averaged over about averageSeconds, activity as the share of samples past the knee.
+class LevelMeter
+{
+public:
+    static constexpr double averageSeconds = 0.3;
+    static constexpr double peakFallDecibelsPerSecond = 20.0;
+
+    // Before processing starts, from prepareToPlay
+    void prepare(double sampleRate) noexcept;
+
+    // Audio thread, once per block of blockLength samples. Sums of no samples count as silence.
+    void push(const LevelSums& sums, int blockLength) noexcept;
+
+    // Any thread, linear gains and a share from 0 to 1
+    float getPeak() const noexcept          { return peak.load(std::memory_order_relaxed); }
+    float getRms() const noexcept           { return rms.load(std::memory_order_relaxed); }
+    float getActivity() const noexcept      { return activity.load(std::memory_order_relaxed); }
+
+private:
+    double sampleRate { 44100 };
+
+    // Audio thread
+    float heldPeak { 0 }, meanSquare { 0 }, meanActivity { 0 };
+
+    std::atomic<float> peak { 0 }, rms { 0 }, activity { 0 };
+};
+
+// A read only parameter for hosts that show a plugin's meters. It is never automated or saved; its
+// value is whatever reading() returns, in range's units, clipped to the range. A message thread
+// timer tells the host about it about 30 times a second when it moved, so the audio thread never
+// goes near the parameter's listeners.
+class MeterParameter : public juce::AudioProcessorParameterWithID,
+                       private juce::Timer
+{
+public:
+    MeterParameter(const juce::String& id, const juce::String& label, Category category,
+                   juce::NormalisableRange<float> range, std::function<float()> reading);
+
+    ~MeterParameter() override;
+
+    // Any thread, in range's units
+    float getReading() const;
+
+    float getValue() const override;
+    void setValue(float) override                   {}
+    float getDefaultValue() const override          { return 0; }
+    bool isAutomatable() const override             { return false; }
+
+    juce::String getText(float value, int maximumLength) const override;
+    float getValueForText(const juce::String& text) const override;
+
+private:
+    void timerCallback() override;
+
+    juce::NormalisableRange<float> range;
+    std::function<float()> reading;
+    float lastSent { -1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeterParameter)
+};
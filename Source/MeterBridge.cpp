@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    MeterBridge.cpp
+    Created: 29 Oct 2026 11:02:45am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "MeterBridge.h"
+
+MeterBridge::MeterBridge()
+{
+    setOpaque(true);
+}
+
+void MeterBridge::addMeter(const LevelMeter& meter, const juce::String& name, bool showsActivity)
+{
+    bars.push_back({ &meter, name, showsActivity, 0.f, 0.f, 0.f });
+}
+
+void MeterBridge::update()
+{
+    auto changed = false;
+
+    for (auto& bar : bars)
+    {
+        auto peak = bar.meter->getPeak(), rms = bar.meter->getRms(), activity = bar.meter->getActivity();
+        changed = changed || peak != bar.peak || rms != bar.rms || activity != bar.activity;
+
+        bar.peak = peak;
+        bar.rms = rms;
+        bar.activity = activity;
+    }
+
+    if (changed)
+        repaint();
+}
+
+float MeterBridge::toProportion(float gain) const noexcept
+{
+    auto decibels = juce::Decibels::gainToDecibels(gain, minimumDecibels);
+    return juce::jlimit(0.f, 1.f, (decibels - minimumDecibels) / (maximumDecibels - minimumDecibels));
+}
+
+void MeterBridge::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    if (bars.empty())
+        return;
+
+    auto bounds = getLocalBounds().reduced(4);
+    auto captions = bounds.removeFromBottom(30);
+    auto barWidth = bounds.getWidth() / (int)bars.size();
+
+    // 0 dB across all of them
+    auto zero = (float)bounds.getBottom() - toProportion(1.f) * (float)bounds.getHeight();
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+    g.drawHorizontalLine(juce::roundToInt(zero), (float)bounds.getX(), (float)bounds.getRight());
+
+    g.setFont(juce::Font(11.f));
+
+    for (size_t i = 0; i < bars.size(); ++i)
+    {
+        auto& bar = bars[i];
+        auto column = juce::Rectangle<int>(bounds.getX() + (int)i * barWidth, bounds.getY(), barWidth, bounds.getHeight()).reduced(6, 0);
+        auto height = (float)column.getHeight();
+        auto bottom = (float)column.getBottom();
+
+        auto rmsTop = bottom - toProportion(bar.rms) * height;
+        g.setColour(bar.peak > 1.f ? juce::Colours::orangered : juce::Colours::limegreen);
+        g.fillRect(juce::Rectangle<float>((float)column.getX(), rmsTop, (float)column.getWidth(), bottom - rmsTop));
+
+        g.setColour(juce::Colours::white);
+        g.drawHorizontalLine(juce::roundToInt(bottom - toProportion(bar.peak) * height), (float)column.getX(), (float)column.getRight());
+
+        auto caption = captions.withX(column.getX()).withWidth(column.getWidth());
+        g.setColour(juce::Colours::lightgrey);
+        g.drawText(bar.name, caption.removeFromTop(15), juce::Justification::centred, false);
+
+        if (bar.showsActivity)
+            g.drawText(juce::String(bar.activity * 100.f, 1) + "%", caption, juce::Justification::centred, false);
+    }
+}
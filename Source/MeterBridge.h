@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    MeterBridge.h
+    Created: 29 Oct 2026 11:02:45am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LevelMeter.h"
+
+// A row of LevelMeters as vertical bars: RMS filled, the peak as a line, from minimumDecibels to
+// +6 dB. A meter with an activity readout shows the share of samples past the clipper's knee under
+// its bar. Like Oscilloscope, it reads the meters in update().
+class MeterBridge : public juce::Component
+{
+public:
+    static constexpr float minimumDecibels = -60.f;
+    static constexpr float maximumDecibels = 6.f;
+
+    MeterBridge();
+
+    void addMeter(const LevelMeter& meter, const juce::String& name, bool showsActivity = false);
+
+    // Message thread, throttled by the caller
+    void update();
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    struct Bar
+    {
+        const LevelMeter* meter;
+        juce::String name;
+        bool showsActivity;
+        float peak, rms, activity;
+    };
+
+    float toProportion(float gain) const noexcept;
+
+    std::vector<Bar> bars;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeterBridge)
+};
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    MidiControllerMap.cpp
+    Created: 21 Oct 2026 9:26:15am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "MidiControllerMap.h"
+
+const juce::Identifier MidiControllerMap::treeType { "MidiControllers" };
+
+MidiControllerMap::MidiControllerMap(juce::AudioProcessorValueTreeState& state) : apvts(state)
+{
+    for (auto& p : parameters)
+        p.store(nullptr);
+}
+
+void MidiControllerMap::setMapping(int controller, const juce::String& parameterID)
+{
+    if (! juce::isPositiveAndBelow(controller, numControllers))
+        return;
+
+    parameters[(size_t)controller].store(parameterID.isNotEmpty() ? apvts.getParameter(parameterID) : nullptr);
+}
+
+void MidiControllerMap::clearMappings()
+{
+    for (auto& p : parameters)
+        p.store(nullptr);
+}
+
+juce::String MidiControllerMap::getMapping(int controller) const
+{
+    if (auto* parameter = getParameter(controller))
+        return parameter->paramID;
+
+    return {};
+}
+
+juce::ValueTree MidiControllerMap::toValueTree() const
+{
+    juce::ValueTree tree(treeType);
+
+    for (int cc = 0; cc < numControllers; ++cc)
+        if (auto* parameter = getParameter(cc))
+            tree.appendChild({ "Controller", { { "number", cc }, { "parameter", parameter->paramID } } }, nullptr);
+
+    return tree;
+}
+
+void MidiControllerMap::fromValueTree(const juce::ValueTree& tree)
+{
+    if (! tree.hasType(treeType))
+        return;
+
+    clearMappings();
+
+    for (const auto& child : tree)
+        setMapping((int)child.getProperty("number", -1), child.getProperty("parameter").toString());
+}
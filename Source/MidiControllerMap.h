@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    MidiControllerMap.h
+    Created: 21 Oct 2026 9:26:15am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Which parameter each MIDI continuous controller drives. Edited on the message thread,
+// looked up on the audio thread without locking.
+class MidiControllerMap
+{
+public:
+    static constexpr int numControllers = 128;
+
+    explicit MidiControllerMap(juce::AudioProcessorValueTreeState& state);
+
+    // Message thread. An empty or unknown id removes the mapping.
+    void setMapping(int controller, const juce::String& parameterID);
+    void clearMappings();
+    juce::String getMapping(int controller) const;
+
+    // Audio thread
+    juce::RangedAudioParameter* getParameter(int controller) const noexcept
+    {
+        return juce::isPositiveAndBelow(controller, numControllers) ? parameters[(size_t)controller].load() : nullptr;
+    }
+
+    juce::ValueTree toValueTree() const;
+    void fromValueTree(const juce::ValueTree& tree);
+
+    static const juce::Identifier treeType;
+
+private:
+    juce::AudioProcessorValueTreeState& apvts;
+    std::array<std::atomic<juce::RangedAudioParameter*>, numControllers> parameters {};
+};
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    Oscilloscope.cpp
+    Created: 20 Oct 2026 2:58:20pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Oscilloscope.h"
+
+Oscilloscope::Oscilloscope(AnalyserFifo& f) : fifo(f)
+{
+    setOpaque(true);
+
+    // whatever is left from a previous editor is stale
+    while (fifo.pull(scratch.data(), (int)scratch.size()) > 0) {}
+
+    fifo.setActive(true);
+}
+
+Oscilloscope::~Oscilloscope()
+{
+    fifo.setActive(false);
+}
+
+void Oscilloscope::update()
+{
+    auto numRead = fifo.pull(scratch.data(), (int)scratch.size());
+
+    for (int i = juce::jmax(0, numRead - historySize); i < numRead; ++i)
+    {
+        history[(size_t)historyPosition] = scratch[(size_t)i];
+        historyPosition = (historyPosition + 1) % historySize;
+    }
+
+    if (numRead == 0 && ! path.isEmpty())
+        return;
+
+    auto start = findTrigger();
+    auto width = (float)getWidth();
+    auto centre = (float)getHeight() * 0.5f;
+
+    path.clear();
+
+    for (int i = 0; i < displaySize; ++i)
+    {
+        auto sample = juce::jlimit(-1.f, 1.f, history[(size_t)((start + i) % historySize)]);
+        auto x = width * (float)i / (float)(displaySize - 1);
+        auto y = centre - sample * centre;
+
+        if (i == 0)
+            path.startNewSubPath(x, y);
+        else
+            path.lineTo(x, y);
+    }
+
+    repaint();
+}
+
+int Oscilloscope::findTrigger() const noexcept
+{
+    // search backwards from the newest full window for a rising zero crossing
+    auto newest = historyPosition - displaySize;
+
+    for (int back = 0; back < historySize - displaySize; ++back)
+    {
+        auto i = (newest - back + 2 * historySize) % historySize;
+        auto previous = history[(size_t)((i - 1 + historySize) % historySize)];
+
+        if (previous < 0.f && history[(size_t)i] >= 0.f)
+            return i;
+    }
+
+    return (newest + historySize) % historySize;
+}
+
+void Oscilloscope::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+    g.drawHorizontalLine(getHeight() / 2, 0.f, (float)getWidth());
+
+    g.setColour(juce::Colours::limegreen);
+    g.strokePath(path, juce::PathStrokeType(1.5f));
+}
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    Oscilloscope.h
+    Created: 20 Oct 2026 2:58:20pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyserFifo.h"
+
+// Shows the latest samples of an AnalyserFifo, starting at a rising zero crossing so that
+// periodic signals stand still. Like SpectrumAnalyser, it does its work in update().
+class Oscilloscope : public juce::Component
+{
+public:
+    static constexpr int historySize = 8192;
+    static constexpr int displaySize = 1024;
+
+    explicit Oscilloscope(AnalyserFifo& fifo);
+    ~Oscilloscope() override;
+
+    // Message thread, throttled by the caller
+    void update();
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    int findTrigger() const noexcept;
+
+    AnalyserFifo& fifo;
+
+    std::vector<float> history = std::vector<float>(historySize);
+    std::vector<float> scratch = std::vector<float>(AnalyserFifo::capacity);
+    int historyPosition { 0 };
+
+    juce::Path path;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oscilloscope)
+};
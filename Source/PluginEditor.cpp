@@ -11,15 +11,111 @@
 
 //==============================================================================
 SoftClippingPreampAudioProcessorEditor::SoftClippingPreampAudioProcessorEditor (SoftClippingPreampAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), scope (p.getAnalysers().output)
 {
+    auto& analysers = audioProcessor.getAnalysers();
+    spectrum.addTrace(analysers.preClipper, juce::Colours::skyblue, "Pre clipper");
+    spectrum.addTrace(analysers.postClipper, juce::Colours::orange, "Post clipper");
+
+    auto& meters = audioProcessor.getMeters();
+    meterBridge.addMeter(meters.input, "Input");
+    meterBridge.addMeter(meters.preClipper, "Pre clip", true);
+    meterBridge.addMeter(meters.postClipper, "Post clip");
+    meterBridge.addMeter(meters.output, "Output");
+
+    addAndMakeVisible(spectrum);
+    addAndMakeVisible(scope);
+    addAndMakeVisible(response);
+    addAndMakeVisible(meterBridge);
+
+    // the host's meters are parameters too, but not ones to turn
+    for (auto* parameter : audioProcessor.getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            if (audioProcessor.m_apvts.getParameter(ranged->paramID) != nullptr)
+                addControl(*ranged);
+
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize (400, 300);
+    setSize (900, 780);
+
+    startTimerHz(30);
 }
 
 SoftClippingPreampAudioProcessorEditor::~SoftClippingPreampAudioProcessorEditor()
 {
+    stopTimer();
+}
+
+void SoftClippingPreampAudioProcessorEditor::addControl(juce::RangedAudioParameter& parameter)
+{
+    auto& apvts = audioProcessor.m_apvts;
+    auto id = parameter.paramID;
+
+    if (dynamic_cast<juce::AudioParameterBool*>(&parameter) != nullptr)
+    {
+        // the button shows its own name
+        auto* button = new juce::ToggleButton(id);
+        controls.add(button);
+        buttonAttachments.add(new juce::AudioProcessorValueTreeState::ButtonAttachment(apvts, id, *button));
+        addAndMakeVisible(button);
+        labels.add(nullptr);
+        return;
+    }
+
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(&parameter))
+    {
+        auto* comboBox = new juce::ComboBox(id);
+        comboBox->addItemList(choice->choices, 1);
+        controls.add(comboBox);
+        comboBoxAttachments.add(new juce::AudioProcessorValueTreeState::ComboBoxAttachment(apvts, id, *comboBox));
+        addAndMakeVisible(comboBox);
+    }
+    else
+    {
+        auto* slider = new juce::Slider(juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow);
+        slider->setTextBoxStyle(juce::Slider::TextBoxBelow, false, 70, 16);
+        controls.add(slider);
+        sliderAttachments.add(new juce::AudioProcessorValueTreeState::SliderAttachment(apvts, id, *slider));
+        addAndMakeVisible(slider);
+    }
+
+    auto* label = labels.add(new juce::Label({}, id));
+    label->setJustificationType(juce::Justification::centred);
+    label->setFont(juce::Font(12.f));
+    addAndMakeVisible(label);
+}
+
+void SoftClippingPreampAudioProcessorEditor::timerCallback()
+{
+    // All the analysis runs here, at the timer's rate, never on the audio thread
+    spectrum.setSampleRate(audioProcessor.getSampleRate() > 0 ? audioProcessor.getSampleRate() : 44100.0);
+    spectrum.update();
+    scope.update();
+    meterBridge.update();
+
+    updateResponse();
+}
+
+void SoftClippingPreampAudioProcessorEditor::updateResponse()
+{
+    auto sampleRate = audioProcessor.getSampleRate();
+    auto settings = audioProcessor.getSettings();
+
+    if (sampleRate <= 0 || (settings == displayedSettings && sampleRate == displayedSampleRate))
+        return;
+
+    displayedSettings = settings;
+    displayedSampleRate = sampleRate;
+
+    response.setSampleRate(sampleRate);
+
+    // the curves whose coefficients didn't change keep their cached response
+    ResponseCurve::CoefficientsArray highShelf;
+    highShelf.add(audioProcessor.makeHighShelf(settings));
+
+    response.setFilter(0, audioProcessor.makeLowPass2(settings), true);
+    response.setFilter(1, highShelf, audioProcessor.isHighShelfEnabled());
+    response.setFilter(2, audioProcessor.makeToneStackFilter(settings), true);
 }
 
 //==============================================================================
@@ -27,14 +123,41 @@ void SoftClippingPreampAudioProcessorEditor::paint (juce::Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (15.0f);
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
 }
 
 void SoftClippingPreampAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
+    auto bounds = getLocalBounds().reduced(8);
+
+    auto displays = bounds.removeFromTop(260);
+    scope.setBounds(displays.removeFromRight(280));
+    displays.removeFromRight(8);
+    spectrum.setBounds(displays);
+
+    bounds.removeFromTop(8);
+    auto middle = bounds.removeFromTop(150);
+    meterBridge.setBounds(middle.removeFromRight(280));
+    middle.removeFromRight(8);
+    response.setBounds(middle);
+
+    bounds.removeFromTop(8);
+
+    constexpr int columns = 6;
+    auto cellWidth = bounds.getWidth() / columns;
+    auto rows = (controls.size() + columns - 1) / columns;
+    auto cellHeight = rows > 0 ? bounds.getHeight() / rows : 0;
+
+    for (int i = 0; i < controls.size(); ++i)
+    {
+        juce::Rectangle<int> cell(bounds.getX() + (i % columns) * cellWidth, bounds.getY() + (i / columns) * cellHeight, cellWidth, cellHeight);
+        cell.reduce(4, 4);
+
+        if (auto* label = labels[i])
+            label->setBounds(cell.removeFromTop(16));
+
+        if (dynamic_cast<juce::Slider*>(controls[i]) != nullptr)
+            controls[i]->setBounds(cell);
+        else
+            controls[i]->setBounds(cell.withSizeKeepingCentre(cell.getWidth(), 24));
+    }
 }
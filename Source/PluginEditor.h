@@ -10,11 +10,16 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "SpectrumAnalyser.h"
+#include "Oscilloscope.h"
+#include "ResponseCurve.h"
+#include "MeterBridge.h"
 
 //==============================================================================
 /**
 */
-class SoftClippingPreampAudioProcessorEditor  : public juce::AudioProcessorEditor
+class SoftClippingPreampAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                                private juce::Timer
 {
 public:
     SoftClippingPreampAudioProcessorEditor (SoftClippingPreampAudioProcessor&);
@@ -25,9 +30,29 @@ public:
     void resized() override;
 
 private:
+    void timerCallback() override;
+    void addControl(juce::RangedAudioParameter& parameter);
+    void updateResponse();
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     SoftClippingPreampAudioProcessor& audioProcessor;
 
+    SpectrumAnalyser spectrum;
+    Oscilloscope scope;
+    MeterBridge meterBridge;
+
+    // LowPass2, HighShelf and ToneStack, redesigned when the parameters move
+    ResponseCurve response { 3 };
+    Settings displayedSettings;
+    double displayedSampleRate { 0 };
+
+    // One control per parameter. The attachments go first on destruction.
+    juce::OwnedArray<juce::Component> controls;
+    juce::OwnedArray<juce::Label> labels;
+    juce::OwnedArray<juce::AudioProcessorValueTreeState::SliderAttachment> sliderAttachments;
+    juce::OwnedArray<juce::AudioProcessorValueTreeState::ButtonAttachment> buttonAttachments;
+    juce::OwnedArray<juce::AudioProcessorValueTreeState::ComboBoxAttachment> comboBoxAttachments;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SoftClippingPreampAudioProcessorEditor)
 };
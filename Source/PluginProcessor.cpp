@@ -23,12 +23,54 @@ SoftClippingPreampAudioProcessor::SoftClippingPreampAudioProcessor()
                        )
 #endif
 {
+    if (programBank.loadFromDirectory(ProgramBank::getDefaultDirectory()) == 0)
+        programBank.add({ "Default", m_apvts.copyState() });
+
+    leftProcessChain.get<ChainPositions::PreClipperTap>().setFifo(&analysers.preClipper);
+    leftProcessChain.get<ChainPositions::PostClipperTap>().setFifo(&analysers.postClipper);
+    leftProcessChain.get<ChainPositions::OutputTap>().setFifo(&analysers.output);
+
+    midiControllers.setMapping(1, Parameters::k_drive);         // mod wheel
+    midiControllers.setMapping(7, Parameters::k_output_level);  // channel volume
+    midiControllers.setMapping(11, Parameters::k_volume);       // expression
+    midiControllers.setMapping(14, Parameters::k_bass);
+    midiControllers.setMapping(15, Parameters::k_mid);
+    midiControllers.setMapping(16, Parameters::k_treble);
+    midiControllers.setMapping(17, Parameters::k_input_level);
+
+    // Peaks in dB and the clipper's activity in percent, for hosts that show a plugin's meters
+    auto peakDecibels = [] (const LevelMeter& meter)
+    {
+        return [&meter] { return juce::Decibels::gainToDecibels(meter.getPeak(), -60.f); };
+    };
+
+    addParameter(new MeterParameter(Parameters::k_input_meter, "dB", juce::AudioProcessorParameter::inputMeter,
+                                    { -60.f, 6.f }, peakDecibels(meters.input)));
+    addParameter(new MeterParameter(Parameters::k_output_meter, "dB", juce::AudioProcessorParameter::outputMeter,
+                                    { -60.f, 6.f }, peakDecibels(meters.output)));
+    addParameter(new MeterParameter(Parameters::k_clipping_meter, "%", juce::AudioProcessorParameter::otherMeter,
+                                    { 0.f, 100.f }, [this] { return meters.preClipper.getActivity() * 100.f; }));
+
+    // Callback timings every so many seconds, for tracking down glitches on a machine without a profiler
+    auto logSeconds = juce::SystemStats::getEnvironmentVariable("SOFTCLIPPINGPREAMP_DEADLINE_LOG", {}).getDoubleValue();
+
+    if (logSeconds > 0)
+        deadlineMonitor.setLogInterval(logSeconds);
+
+    // The kernels for this CPU get picked here rather than in the first audio callback
+    SimdKernels::get();
+
     Settings settings = getSettings();
     makeConvolutionFilter(settings);
+
+    // hands the mapped CCs on to their parameters
+    startTimerHz(30);
 }
 
 SoftClippingPreampAudioProcessor::~SoftClippingPreampAudioProcessor()
 {
+    stopTimer();
+    channelJob.waitUntilReleased();
 }
 
 //==============================================================================
@@ -71,26 +113,52 @@ double SoftClippingPreampAudioProcessor::getTailLengthSeconds() const
 
 int SoftClippingPreampAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, programBank.size());   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                                                // so this should be at least 1, even if you're not really implementing programs.
 }
 
 int SoftClippingPreampAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram.load();
 }
 
 void SoftClippingPreampAudioProcessor::setCurrentProgram (int index)
 {
+    if (! juce::isPositiveAndBelow(index, programBank.size()))
+        return;
+
+    // The audio thread switches to the precomputed snapshot, the parameters follow on the message thread
+    currentProgram.store(index);
+    pendingProgram.store(index);
+    programChangePending.store(true);
+    triggerAsyncUpdate();
 }
 
 const juce::String SoftClippingPreampAudioProcessor::getProgramName (int index)
 {
+    if (juce::isPositiveAndBelow(index, programBank.size()))
+        return programBank[index].name;
+
     return {};
 }
 
 void SoftClippingPreampAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    programBank.setName(index, newName);
+}
+
+int SoftClippingPreampAudioProcessor::loadProgramsFromDirectory(const juce::File& directory)
+{
+    auto numLoaded = programBank.loadFromDirectory(directory);
+
+    if (numLoaded > 0)
+    {
+        currentProgram.store(0);
+        publishProgramSnapshots();
+        updateHostDisplay();
+    }
+
+    return numLoaded;
 }
 
 Coefficients makeMiddleBand(const Settings& settings, double sampleRate)
@@ -104,51 +172,82 @@ Coefficients makeMiddleBand(const Settings& settings, double sampleRate)
 //==============================================================================
 void SoftClippingPreampAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    // Hosts that prepare on their audio thread get its trace ring here rather than a spare
+    TRACE_THREAD();
+
     juce::dsp::ProcessSpec spec;
 
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = 1;
     spec.sampleRate = sampleRate;
 
+    deadlineMonitor.prepare(sampleRate, samplesPerBlock);
+
     auto settings = getSettings();
 
+    // Hosts prepare again before an offline bounce, which then runs at the highest quality
+    renderingOffline = isNonRealtime();
+    auto quality = renderingOffline ? Quality::High : (Quality)settings.quality;
+
+    for (auto* cabinet : { &leftProcessChain.get<ChainPositions::Cabinet>(), &rightProcessChain.get<ChainPositions::Cabinet>() })
+    {
+        cabinet->setThreadedTail(settings.threaded_cabinet);
+        cabinet->setMaximumLength(QualitySettings::get(quality).cabinetSeconds);
+    }
+
     leftProcessChain.reset();
     leftProcessChain.prepare(spec);
     rightProcessChain.reset();
     rightProcessChain.prepare(spec);
 
+    updateChain(settings);
 
-    makeAmplification(settings, ChainPositions::Input);
+    // Nothing is playing yet, so the tier's factor takes over right away
+    for (auto* clipper : { &leftProcessChain.get<ChainPositions::Clipping>(), &rightProcessChain.get<ChainPositions::Clipping>() })
+        clipper->setOversamplingOrder(clipper->getPreparedOversamplingOrder());
 
-    auto lowPassFilter = makeClipperLowPass();
-    updateCoefficients(leftProcessChain.get<ChainPositions::LowPass>().coefficients, lowPassFilter[0]); // it's a first order filter, so 0 must exist
-    updateCoefficients(rightProcessChain.get<ChainPositions::LowPass>().coefficients, lowPassFilter[0]);
+    // the clipping stages run oversampled
+    setLatencySamples(juce::roundToInt(leftProcessChain.get<ChainPositions::Clipping>().getLatencyInSamples()));
+    reportedOversamplingOrder.store(leftProcessChain.get<ChainPositions::Clipping>().getOversamplingOrder());
 
-    makeWaveShaper(settings);
-    leftProcessChain.get<ChainPositions::ToneStack>().reset();
-    rightProcessChain.get<ChainPositions::ToneStack>().reset();
+    // after updateChain, so the levels start at their values instead of ramping there
+    for (auto* chain : { &leftProcessChain, &rightProcessChain })
+    {
+        chain->get<ChainPositions::Input>().setRampDurationSeconds(0.02);
+        chain->get<ChainPositions::Volume>().setRampDurationSeconds(0.02);
+        chain->get<ChainPositions::Output>().setRampDurationSeconds(0.02);
+    }
 
-    auto lowPass2 = makeLowPass2(settings);
-    updateCoefficients(leftProcessChain.get<ChainPositions::LowPass2>().coefficients, lowPass2[0]);
-    updateCoefficients(rightProcessChain.get<ChainPositions::LowPass2>().coefficients, lowPass2[0]);
+    smoother.prepare(sampleRate, 0.02);
+    smoother.setCurrentAndTarget(settings);
 
-    auto highShelf = makeHighShelf(settings);
-    updateCoefficients(leftProcessChain.get<ChainPositions::HighShelf>().coefficients, highShelf);
-    updateCoefficients(rightProcessChain.get<ChainPositions::HighShelf>().coefficients, highShelf);
-    leftProcessChain.setBypassed<ChainPositions::HighShelf>(true);
-    rightProcessChain.setBypassed<ChainPositions::HighShelf>(true);
+    monoMix.reset(sampleRate, 0.02);
+    monoMix.setCurrentAndTargetValue(0.f);
+    identicalSamples = 0;
+    dualMonoHoldSamples = (int)(sampleRate * 0.5);
 
-    auto coefficients = makeToneStackFilter(settings);
-    updateCoefficients(leftProcessChain.get<ChainPositions::ToneStack>().coefficients, coefficients);
-    updateCoefficients(rightProcessChain.get<ChainPositions::ToneStack>().coefficients, coefficients);
-    leftProcessChain.get<ChainPositions::ToneStack>().reset();
-    rightProcessChain.get<ChainPositions::ToneStack>().reset();
+    // Long enough for the latency of any oversampling factor, a tier change doesn't reallocate
+    auto maximumLatency = 0.f;
 
-    makeAmplification(settings, ChainPositions::Volume);
+    for (int order = 0; order <= ClipperCascade::maxOversamplingOrder; ++order)
+        maximumLatency = juce::jmax(maximumLatency, leftProcessChain.get<ChainPositions::Clipping>().getLatencyInSamples(order));
+
+    dryBuffer.setSize(2, samplesPerBlock);
+    dryHistory.setSize(2, juce::roundToInt(maximumLatency) + 1);
+    dryHistory.clear();
+    dryWritePosition = 0;
+
+    bypassMix.reset(sampleRate, 0.02);
+    bypassMix.setCurrentAndTargetValue(m_apvts.getRawParameterValue(Parameters::k_bypass)->load() > 0.5f ? 1.f : 0.f);
+
+    for (auto* meter : { &meters.input, &meters.preClipper, &meters.postClipper, &meters.output })
+        meter->prepare(sampleRate);
+
+    resetToneStack();
 
     makeConvolutionFilter(settings);
 
-    makeAmplification(settings, ChainPositions::Output);
+    publishProgramSnapshots();
 }
 
 void SoftClippingPreampAudioProcessor::releaseResources()
@@ -185,56 +284,384 @@ bool SoftClippingPreampAudioProcessor::isBusesLayoutSupported (const BusesLayout
 
 void SoftClippingPreampAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    TRACE_INSTANCE_SCOPE("processBlock", deadlineMonitor.getInstanceNumber());
+    const DeadlineMonitor::ScopedCallback measurement(deadlineMonitor, buffer.getNumSamples(), ! isNonRealtime());
+
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    auto settings = getSettings();
+    if (auto* snapshot = statePublisher.beginRead(); snapshot != nullptr && snapshot->generation != appliedGeneration)
+    {
+        appliedGeneration = snapshot->generation;
+        applySnapshot(*snapshot);
+        observedSettings = snapshot->settings;
+    }
 
-    makeAmplification(settings, ChainPositions::Input);
+    statePublisher.endRead();
 
-    auto lowPassFilter = makeClipperLowPass();
-    updateCoefficients(leftProcessChain.get<ChainPositions::LowPass>().coefficients, lowPassFilter[0]); // it's a first order filter, so 0 must exist
-    updateCoefficients(rightProcessChain.get<ChainPositions::LowPass>().coefficients, lowPassFilter[0]);
+    applyPendingProgram(midiMessages);
 
-    makeWaveShaper(settings);
+    if (isNonRealtime() != renderingOffline)
+    {
+        renderingOffline = ! renderingOffline;
+        makeQuality(activeSettings);
+    }
 
-    auto coefficients = makeToneStackFilter(settings);
-    updateCoefficients(leftProcessChain.get<ChainPositions::ToneStack>().coefficients, coefficients);
-    updateCoefficients(rightProcessChain.get<ChainPositions::ToneStack>().coefficients, coefficients);
+    sendControllers();
+    updateFromParameters();
+    switchOversampling();
 
-    auto lowPass2 = makeLowPass2(settings);
-    updateCoefficients(leftProcessChain.get<ChainPositions::LowPass2>().coefficients, lowPass2[0]);
-    updateCoefficients(rightProcessChain.get<ChainPositions::LowPass2>().coefficients, lowPass2[0]);
+    // offline renders compute the cabinet tail in line, so they come out the same every time
+    leftProcessChain.get<ChainPositions::Cabinet>().setNonRealtime(isNonRealtime());
+    rightProcessChain.get<ChainPositions::Cabinet>().setNonRealtime(isNonRealtime());
 
-    auto highShelf = makeHighShelf(settings);
-    updateCoefficients(leftProcessChain.get<ChainPositions::HighShelf>().coefficients, highShelf);
-    updateCoefficients(rightProcessChain.get<ChainPositions::HighShelf>().coefficients, highShelf);
-    leftProcessChain.setBypassed<ChainPositions::HighShelf>(true);
-    rightProcessChain.setBypassed<ChainPositions::HighShelf>(true);
+    inputLevels = {};
+    leftLevels = rightLevels = {};
 
-    makeAmplification(settings, ChainPositions::Volume);
+    updateBypass(buffer);
 
-    //makeConvolutionFilter(settings);
+    juce::dsp::AudioBlock<float> block(buffer);
+    auto numSamples = block.getNumSamples();
 
-    makeAmplification(settings, ChainPositions::Output);
+    // Mapped CCs split the block: the part before one runs with the old design, the rest with the new.
+    // Several at the same sample only cost one redesign.
+    size_t position = 0;
+    bool changed = false;
 
+    for (const auto metadata : midiMessages)
+    {
+        auto message = metadata.getMessage();
 
-    juce::dsp::AudioBlock<float> block(buffer);
+        if (! message.isController())
+            continue;
+
+        auto* parameter = midiControllers.getParameter(message.getControllerNumber());
+
+        if (parameter == nullptr)
+            continue;
 
+        auto samplePosition = juce::jlimit(position, numSamples, (size_t)juce::jmax(0, metadata.samplePosition));
+
+        if (samplePosition > position)
+        {
+            if (changed)
+                updateFromParameters();
+
+            processSegment(block, position, samplePosition);
+            position = samplePosition;
+            changed = false;
+        }
+
+        // the settings follow at once, the parameter once the message thread has set it
+        applyController(parameter, (float)message.getControllerValue() / 127.f);
+        changed = true;
+    }
+
+    if (changed)
+        updateFromParameters();
+
+    if (position < numSamples)
+        processSegment(block, position, numSamples);
+
+    mixBypass(buffer);
+    publishMeters(buffer.getNumSamples());
+}
+
+juce::AudioProcessorParameter* SoftClippingPreampAudioProcessor::getBypassParameter() const
+{
+    return m_apvts.getParameter(Parameters::k_bypass);
+}
+
+void SoftClippingPreampAudioProcessor::updateBypass(const juce::AudioBuffer<float>& buffer)
+{
+    auto bypassed = m_apvts.getRawParameterValue(Parameters::k_bypass)->load() > 0.5f;
+
+    if (bypassed != (bypassMix.getTargetValue() == 1.f))
+    {
+        // The chains have been idle since the bypass got fully engaged, their state is stale
+        if (! bypassed && ! bypassMix.isSmoothing())
+        {
+            leftProcessChain.reset();
+            rightProcessChain.reset();
+        }
+
+        bypassMix.setTargetValue(bypassed ? 1.f : 0.f);
+    }
+
+    chainsIdle = bypassMix.getTargetValue() == 1.f && ! bypassMix.isSmoothing();
+
+    // The dry path, delayed by the latency the chains have now. The host compensates for the same amount
+    // once the message thread has reported it.
+    auto numSamples = buffer.getNumSamples();
+    auto numChannels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+    auto historySize = dryHistory.getNumSamples();
+    auto delay = juce::jlimit(0, historySize - 1, juce::roundToInt(leftProcessChain.get<ChainPositions::Clipping>().getLatencyInSamples()));
+
+    jassert(numSamples <= dryBuffer.getNumSamples());
+
+    // The input meter measures in the same loop, it reads every input sample already
+    auto peak = 0.f, sumOfSquares = 0.f;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* input = buffer.getReadPointer(channel);
+        auto* history = dryHistory.getWritePointer(channel);
+        auto* dry = dryBuffer.getWritePointer(channel);
+        auto write = dryWritePosition;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            history[write] = input[i];
+
+            peak = juce::jmax(peak, std::abs(input[i]));
+            sumOfSquares += input[i] * input[i];
+
+            auto read = write - delay;
+            dry[i] = history[read < 0 ? read + historySize : read];
+
+            if (++write == historySize)
+                write = 0;
+        }
+    }
+
+    dryWritePosition = (dryWritePosition + numSamples) % historySize;
+
+    inputLevels.levels = { peak, sumOfSquares };
+    inputLevels.numSamples = (size_t)(numSamples * numChannels);
+}
+
+void SoftClippingPreampAudioProcessor::mixBypass(juce::AudioBuffer<float>& buffer)
+{
+    auto numSamples = buffer.getNumSamples();
+    auto numChannels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+
+    if (chainsIdle)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.copyFrom(channel, 0, dryBuffer, channel, 0, numSamples);
+
+        return;
+    }
+
+    if (! bypassMix.isSmoothing())
+        return;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto mix = bypassMix.getNextValue();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* output = buffer.getWritePointer(channel);
+            output[i] += (dryBuffer.getSample(channel, i) - output[i]) * mix;
+        }
+    }
+}
+
+void SoftClippingPreampAudioProcessor::publishMeters(int numSamples)
+{
+    meters.input.push(inputLevels, numSamples);
+
+    if (chainsIdle)
+    {
+        // Nothing but the delayed input went out. The clipper meters fall back to silence.
+        meters.preClipper.push({}, numSamples);
+        meters.postClipper.push({}, numSamples);
+        meters.output.push(inputLevels, numSamples);
+    }
+    else
+    {
+        // Only the chains that ran measured anything, dual mono copies the left channel's output
+        for (auto [sums, meter] : { std::make_pair(&ChainLevels::preClipper, &meters.preClipper),
+                                    std::make_pair(&ChainLevels::postClipper, &meters.postClipper),
+                                    std::make_pair(&ChainLevels::output, &meters.output) })
+        {
+            auto both = leftLevels.*sums;
+            both.add(rightLevels.*sums);
+            meter->push(both, numSamples);
+        }
+    }
+}
+
+void SoftClippingPreampAudioProcessor::processSegment(juce::dsp::AudioBlock<float>& block, size_t start, size_t end)
+{
+    while (start < end)
+    {
+        // While gliding, redesign every smoothingInterval samples
+        auto length = end - start;
+
+        if (smoother.isSmoothing())
+            length = juce::jmin(length, (size_t)smoothingInterval);
+
+        auto settings = smoother.advance((int)length);
+
+        if (settings != activeSettings)
+            updateChain(settings);
+
+        // fully bypassed, only the designs keep following the parameters
+        if (! chainsIdle)
+        {
+            auto segment = block.getSubBlock(start, length);
+            processChannels(segment);
+        }
+
+        start += length;
+    }
+}
+
+void SoftClippingPreampAudioProcessor::processChannels(juce::dsp::AudioBlock<float>& block)
+{
+    auto numSamples = block.getNumSamples();
     auto leftBlock = block.getSingleChannelBlock(0);
+
+    // A mono bus only has the one channel
+    if (block.getNumChannels() < 2)
+    {
+        processChain(leftProcessChain, leftBlock);
+        return;
+    }
+
     auto rightBlock = block.getSingleChannelBlock(1);
+    auto* left = leftBlock.getChannelPointer(0);
+    auto* right = rightBlock.getChannelPointer(0);
 
-    juce::dsp::ProcessContextReplacing<float> leftProcContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightProcContext(rightBlock);
+    auto identical = std::memcmp(left, right, numSamples * sizeof(float)) == 0;
+    identicalSamples = identical ? juce::jmin(identicalSamples + (int)numSamples, dualMonoHoldSamples) : 0;
 
+    if (monoMix.getTargetValue() == 0.f && identicalSamples >= dualMonoHoldSamples)
+    {
+        // both chains have had the same input for a while, so they sound the same
+        monoMix.setTargetValue(1.f);
+    }
+    else if (monoMix.getTargetValue() == 1.f && ! identical)
+    {
+        // The right chain has been idle since it last ran. Until now it would have had the same input
+        // as the left one, so it carries on from where that one is.
+        if (! monoMix.isSmoothing())
+            copyChainState(leftProcessChain, rightProcessChain);
 
-    leftProcessChain.process(leftProcContext);
-    rightProcessChain.process(rightProcContext);
+        monoMix.setTargetValue(0.f);
+    }
 
+    if (monoMix.getTargetValue() == 1.f && ! monoMix.isSmoothing())
+    {
+        processChain(leftProcessChain, leftBlock);
+        std::copy(left, left + numSamples, right);
+        return;
+    }
+
+    processBothChains(leftBlock, rightBlock);
+
+    if (monoMix.isSmoothing())
+        for (size_t i = 0; i < numSamples; ++i)
+            right[i] += (left[i] - right[i]) * monoMix.getNextValue();
+}
 
+void SoftClippingPreampAudioProcessor::copyChainState(ProcessChain& from, ProcessChain& to) noexcept
+{
+    // The gains and filters are designed alike in both chains, their smoothing and state get copied too
+    to.get<ChainPositions::Input>() = from.get<ChainPositions::Input>();
+    to.get<ChainPositions::LowPass>() = from.get<ChainPositions::LowPass>();
+    to.get<ChainPositions::Clipping>().copyStateFrom(from.get<ChainPositions::Clipping>());
+    to.get<ChainPositions::ToneFilters>() = from.get<ChainPositions::ToneFilters>();
+    to.get<ChainPositions::Volume>() = from.get<ChainPositions::Volume>();
+    to.get<ChainPositions::Cabinet>().copyStateFrom(from.get<ChainPositions::Cabinet>());
+    to.get<ChainPositions::Output>() = from.get<ChainPositions::Output>();
+}
+
+void SoftClippingPreampAudioProcessor::processBothChains(juce::dsp::AudioBlock<float>& leftBlock, juce::dsp::AudioBlock<float>& rightBlock)
+{
+    // Realtime callbacks and short blocks stay on the calling thread, a hand-off costs more than it saves there
+    if (! renderingOffline || leftBlock.getNumSamples() < parallelBlockSize || ! parallelOfflineChannels.load()
+         || workerPool->getNumWorkers() == 0)
+    {
+        processChain(leftProcessChain, leftBlock);
+        processChain(rightProcessChain, rightBlock);
+        return;
+    }
+
+    // The chains share nothing, and offline the cabinet tails run in line instead of on the pool
+    channelJob.owner = this;
+    channelJob.chain = &rightProcessChain;
+    channelJob.block = rightBlock;
+
+    if (! workerPool->submit(channelJob))
+        channelJob.runNow();
+
+    processChain(leftProcessChain, leftBlock);
+    channelJob.finish();
+}
+
+void SoftClippingPreampAudioProcessor::processChain(ProcessChain& chain, juce::dsp::AudioBlock<float>& block)
+{
+    // The same order as ProcessChain::process, but the per sample stages on either side of the
+    // oversampled clipper each run as one fused pass instead of a pass per stage
+    auto* data = block.getChannelPointer(0);
+    auto numSamples = block.getNumSamples();
+    juce::dsp::ProcessContextReplacing<float> context(block);
+
+    // The meters ride along in those passes. The first clipping stage bends away from its input past
+    // |drive x| = 1, samples beyond that count as clipped.
+    auto& levels = &chain == &rightProcessChain ? rightLevels : leftLevels;
+    MeterTap preClipperMeter { levels.preClipper, 1.f / juce::jmax(activeSettings.drive, 1.0e-3f) };
+
+    for (auto* sums : { &levels.preClipper, &levels.postClipper, &levels.output })
+        sums->numSamples += numSamples;
+
+    {
+        TRACE_SCOPE("Input, LowPass");
+        processFused(data, numSamples, chain.get<ChainPositions::Input>(), chain.get<ChainPositions::LowPass>(), preClipperMeter);
+    }
+
+    chain.get<ChainPositions::PreClipperTap>().process(context);
+
+    {
+        TRACE_SCOPE("Clipping");
+        chain.get<ChainPositions::Clipping>().process(context);
+    }
+
+    chain.get<ChainPositions::PostClipperTap>().process(context);
+
+    {
+        TRACE_SCOPE("ToneFilters, Volume");
+        processFusedCascade(data, numSamples, chain.get<ChainPositions::ToneFilters>(), chain.get<ChainPositions::Volume>(),
+                            levels.postClipper);
+    }
+
+    {
+        TRACE_SCOPE("Cabinet");
+        chain.get<ChainPositions::Cabinet>().process(context);
+    }
+
+    auto& output = chain.get<ChainPositions::Output>();
+
+    if (output.isSmoothing())
+    {
+        MeterTap outputMeter { levels.output };
+        processFused(data, numSamples, output, outputMeter);
+    }
+    else
+    {
+        SimdKernels::get().multiplyAndMeasure(data, numSamples, output.getGainLinear(), levels.output.levels);
+    }
+
+    chain.get<ChainPositions::OutputTap>().process(context);
+}
+
+void SoftClippingPreampAudioProcessor::updateFromParameters()
+{
+    // Only move the target when the parameters moved. After a program change they still hold the previous
+    // program's values until the message thread catches up, which must not undo the switch.
+    auto settings = getControlledSettings();
+
+    if (settings != observedSettings)
+    {
+        observedSettings = settings;
+        smoother.setTarget(settings);
+    }
 }
 
 //==============================================================================
@@ -245,93 +672,199 @@ bool SoftClippingPreampAudioProcessor::hasEditor() const
 
 juce::AudioProcessorEditor* SoftClippingPreampAudioProcessor::createEditor()
 {
-    //return new SoftClippingPreampAudioProcessorEditor (*this);
-    return new juce::GenericAudioProcessorEditor(*this);
+    return new SoftClippingPreampAudioProcessorEditor (*this);
 }
 
 //==============================================================================
 void SoftClippingPreampAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
+    auto state = m_apvts.copyState();
+    state.setProperty("program", currentProgram.load(), nullptr);
+    state.appendChild(midiControllers.toValueTree(), nullptr);
+
     juce::MemoryOutputStream mos(destData, true);
-    m_apvts.state.writeToStream(mos);
+    state.writeToStream(mos);
 }
 
 void SoftClippingPreampAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
+    TRACE_INSTANCE_SCOPE("State restore", deadlineMonitor.getInstanceNumber());
+
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
 
     if (tree.isValid()) {
+        // older states have no controller map and keep the current one
+        auto controllers = tree.getChildWithName(MidiControllerMap::treeType);
+
+        if (controllers.isValid())
+        {
+            midiControllers.fromValueTree(controllers);
+            tree.removeChild(controllers, nullptr);
+        }
+
         m_apvts.replaceState(tree);
+        currentProgram.store(juce::jlimit(0, getNumPrograms() - 1, (int)tree.getProperty("program", 0)));
 
+        // Design the whole configuration here and let the audio thread pick it up at the start of its next block.
+        // Before the first prepareToPlay there is no rate to design for, prepareToPlay will read the parameters itself.
         Settings settings = getSettings();
-        
-        makeAmplification(settings, ChainPositions::Input);
 
-        auto lowPassFilter = makeClipperLowPass();
-        updateCoefficients(leftProcessChain.get<ChainPositions::LowPass>().coefficients, lowPassFilter[0]);
-        updateCoefficients(rightProcessChain.get<ChainPositions::LowPass>().coefficients, lowPassFilter[0]);
+        if (getSampleRate() > 0)
+            statePublisher.publish(makeSnapshot(settings));
 
-        makeWaveShaper(settings);
-        
-        auto lowPass2 = makeLowPass2(settings);
-        updateCoefficients(leftProcessChain.get<ChainPositions::LowPass2>().coefficients, lowPass2[0]);
-        updateCoefficients(rightProcessChain.get<ChainPositions::LowPass2>().coefficients, lowPass2[0]);
+        makeConvolutionFilter(settings);
+    }
+}
 
-        auto highShelf = makeHighShelf(settings);
-        updateCoefficients(leftProcessChain.get<ChainPositions::HighShelf>().coefficients, highShelf);
-        updateCoefficients(rightProcessChain.get<ChainPositions::HighShelf>().coefficients, highShelf);
+namespace
+{
+    // Which parameter each field of Settings comes from, value(id) giving the parameter's value
+    template <typename ValueFunction>
+    Settings makeSettings(ValueFunction&& value)
+    {
+        Settings settings;
+
+        settings.input_level = value(Parameters::k_input_level);
+        settings.drive = value(Parameters::k_drive);
+        settings.low_pass_freq = value(Parameters::k_low_pass_freq);
+        settings.high_shelf_freq = value(Parameters::k_high_shelf_freq);
+        settings.high_shelf_gain = value(Parameters::k_high_shelf_gain);
+        settings.high_shelf_q = value(Parameters::k_high_shelf_q);
+        settings.low_gain = value(Parameters::k_bass);
+        settings.middle_gain = value(Parameters::k_mid);
+        settings.treble_gain = value(Parameters::k_treble);
+        settings.volume = value(Parameters::k_volume);
+        settings.output_level = value(Parameters::k_output_level);
+        settings.clipper_type = (int)value(Parameters::k_clipper_type);
+        settings.clipper_adaa = value(Parameters::k_clipper_adaa) > 0.5f;
+        settings.gain_stages = (int)value(Parameters::k_gain_stages);
+        settings.stage_drive = value(Parameters::k_stage_drive);
+        settings.threaded_cabinet = value(Parameters::k_threaded_cabinet) > 0.5f;
+        settings.light_cabinet = value(Parameters::k_light_cabinet) > 0.5f;
+        settings.quality = (int)value(Parameters::k_quality);
+        settings.mic1_level = value(Parameters::k_mic1_level);
+        settings.mic1_invert = value(Parameters::k_mic1_invert) > 0.5f;
+        settings.mic1_offset = value(Parameters::k_mic1_offset);
+        settings.mic2_level = value(Parameters::k_mic2_level);
+        settings.mic2_invert = value(Parameters::k_mic2_invert) > 0.5f;
+        settings.mic2_offset = value(Parameters::k_mic2_offset);
+
+        return settings;
+    }
+}
 
-        makeToneStackFilter(settings);
-        leftProcessChain.get<ChainPositions::ToneStack>().reset();
-        rightProcessChain.get<ChainPositions::ToneStack>().reset();
+Settings SoftClippingPreampAudioProcessor::getSettings()
+{
+    return makeSettings([this] (const char* id) { return m_apvts.getRawParameterValue(id)->load(); });
+}
 
-        makeAmplification(settings, ChainPositions::Volume);
+Settings SoftClippingPreampAudioProcessor::getSettings(const juce::ValueTree& state)
+{
+    // Values missing from the state fall back to the parameter defaults
+    return makeSettings([this, &state] (const char* id) {
+        auto* param = m_apvts.getParameter(id);
+        auto child = state.getChildWithProperty("id", juce::String(id));
 
-        makeConvolutionFilter(settings);
+        if (child.isValid())
+            return param->getNormalisableRange().snapToLegalValue((float)child.getProperty("value"));
 
-        makeAmplification(settings, ChainPositions::Output);
+        return param->convertFrom0to1(param->getDefaultValue());
+    });
+}
+
+// Audio thread: the parameters, with the CCs the message thread hasn't set on them yet
+Settings SoftClippingPreampAudioProcessor::getControlledSettings()
+{
+    return makeSettings([this] (const char* id) {
+        for (int i = 0; i < numPendingControllers; ++i)
+            if (pendingControllers[(size_t)i].parameter->paramID == id)
+                return pendingControllers[(size_t)i].parameter->convertFrom0to1(pendingControllers[(size_t)i].value);
 
+        return m_apvts.getRawParameterValue(id)->load();
+    });
+}
+
+// Audio thread
+void SoftClippingPreampAudioProcessor::applyController(juce::RangedAudioParameter* parameter, float normalisedValue) noexcept
+{
+    auto end = pendingControllers.begin() + numPendingControllers;
+    auto controller = std::find_if(pendingControllers.begin(), end,
+                                   [parameter] (const PendingController& c) { return c.parameter == parameter; });
+
+    if (controller == end)
+    {
+        jassert(numPendingControllers < (int)pendingControllers.size());
+        ++numPendingControllers;
     }
+
+    controller->parameter = parameter;
+    controller->value = normalisedValue;
+    controller->sent = false;
+    sendController(*controller);
 }
 
-Settings SoftClippingPreampAudioProcessor::getSettings()
+// Audio thread: lets go of the CCs the parameters hold now and sends the ones that didn't fit before
+void SoftClippingPreampAudioProcessor::sendControllers() noexcept
 {
-    Settings settings;
+    auto acknowledged = acknowledgedController.load(std::memory_order_acquire);
+    int kept = 0;
+
+    for (int i = 0; i < numPendingControllers; ++i)
+    {
+        auto& controller = pendingControllers[(size_t)i];
 
-    // Input Volume
-    settings.input_level = m_apvts.getRawParameterValue(Parameters::k_input_level)->load();
+        // sequence numbers wrap, the difference doesn't
+        if (controller.sent && (juce::int32)(acknowledged - controller.sequence) >= 0)
+            continue;
 
-    // Drive
-    settings.drive = m_apvts.getRawParameterValue(Parameters::k_drive)->load();
+        if (! controller.sent)
+            sendController(controller);
 
-    // Low pass freq
-    settings.low_pass_freq = m_apvts.getRawParameterValue(Parameters::k_low_pass_freq)->load();
+        pendingControllers[(size_t)kept++] = controller;
+    }
 
-    // High Shelf freq
-    settings.high_shelf_freq = m_apvts.getRawParameterValue(Parameters::k_high_shelf_freq)->load();
+    numPendingControllers = kept;
+}
 
-    // High Shelf gain
-    settings.high_shelf_gain = m_apvts.getRawParameterValue(Parameters::k_high_shelf_gain)->load();
+void SoftClippingPreampAudioProcessor::sendController(PendingController& controller) noexcept
+{
+    int start1, size1, start2, size2;
+    controllerFifo.prepareToWrite(1, start1, size1, start2, size2);
 
-    // High Shelf q
-    settings.high_shelf_q = m_apvts.getRawParameterValue(Parameters::k_high_shelf_q)->load();
+    if (size1 == 0)
+        return;
 
-    // Bass
-    settings.low_gain = m_apvts.getRawParameterValue(Parameters::k_bass)->load();
+    controller.sequence = ++controllerSequence;
+    controller.sent = true;
+    controllerChanges[(size_t)start1] = controller;
+    controllerFifo.finishedWrite(1);
+}
 
-    // Mid
-    settings.middle_gain = m_apvts.getRawParameterValue(Parameters::k_mid)->load();
-    
-    // Treble
-    settings.treble_gain = m_apvts.getRawParameterValue(Parameters::k_treble)->load();
-    
-    // Volume
-    settings.volume = m_apvts.getRawParameterValue(Parameters::k_volume)->load();
+// Message thread: sets the parameters to the CCs the audio thread has applied already
+void SoftClippingPreampAudioProcessor::timerCallback()
+{
+    int start1, size1, start2, size2;
+    controllerFifo.prepareToRead(controllerFifo.getNumReady(), start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+        return;
+
+    juce::uint32 sequence = 0;
 
-    // Output level
-    settings.output_level = m_apvts.getRawParameterValue(Parameters::k_output_level)->load();
+    auto setParameters = [this, &sequence] (int start, int size)
+    {
+        for (int i = start; i < start + size; ++i)
+        {
+            auto& change = controllerChanges[(size_t)i];
+            change.parameter->setValueNotifyingHost(change.value);
+            sequence = change.sequence;
+        }
+    };
 
-    return settings;
+    setParameters(start1, size1);
+    setParameters(start2, size2);
+    controllerFifo.finishedRead(size1 + size2);
+    acknowledgedController.store(sequence, std::memory_order_release);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SoftClippingPreampAudioProcessor::CreateParameterLayout()
@@ -404,25 +937,154 @@ juce::AudioProcessorValueTreeState::ParameterLayout SoftClippingPreampAudioProce
                                                            juce::NormalisableRange<float>(-50.f, 10.f, 1.f),
                                                            0.f));
 
+    // Clipper curve
+    layout.add(std::make_unique<juce::AudioParameterChoice>(Parameters::k_clipper_type,
+                                                            Parameters::k_clipper_type,
+                                                            ClipperStage::getTypeNames(),
+                                                            0));
+
+    // Clipper ADAA
+    layout.add(std::make_unique<juce::AudioParameterBool>(Parameters::k_clipper_adaa,
+                                                          Parameters::k_clipper_adaa,
+                                                          false));
+
+    // Gain stages
+    layout.add(std::make_unique<juce::AudioParameterInt>(Parameters::k_gain_stages,
+                                                         Parameters::k_gain_stages,
+                                                         1, ClipperCascade::maxStages,
+                                                         1));
+
+    // Drive of the stages after the first
+    layout.add(std::make_unique<juce::AudioParameterFloat>(Parameters::k_stage_drive,
+                                                           Parameters::k_stage_drive,
+                                                           juce::NormalisableRange<float>(1.f, 50.f, 0.1f, 0.5f),
+                                                           8.f));
+
+    // Cabinet tail on the worker threads
+    layout.add(std::make_unique<juce::AudioParameterBool>(Parameters::k_threaded_cabinet,
+                                                          Parameters::k_threaded_cabinet,
+                                                          false));
+
+    // Filters fitted to the cabinet response instead of the convolution
+    layout.add(std::make_unique<juce::AudioParameterBool>(Parameters::k_light_cabinet,
+                                                          Parameters::k_light_cabinet,
+                                                          false));
+
+    // Quality tier
+    layout.add(std::make_unique<juce::AudioParameterChoice>(Parameters::k_quality,
+                                                            Parameters::k_quality,
+                                                            QualitySettings::getNames(),
+                                                            (int)Quality::Standard));
+
+    // Cabinet mic 1
+    layout.add(std::make_unique<juce::AudioParameterFloat>(Parameters::k_mic1_level,
+                                                           Parameters::k_mic1_level,
+                                                           juce::NormalisableRange<float>(CabinetBlend::silenceDecibels, 6.f, 0.1f),
+                                                           0.f));
+
+    layout.add(std::make_unique<juce::AudioParameterBool>(Parameters::k_mic1_invert,
+                                                          Parameters::k_mic1_invert,
+                                                          false));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(Parameters::k_mic1_offset,
+                                                           Parameters::k_mic1_offset,
+                                                           juce::NormalisableRange<float>(0.f, 5.f, 0.01f),
+                                                           0.f));
+
+    // Cabinet mic 2, out of the mix to begin with
+    layout.add(std::make_unique<juce::AudioParameterFloat>(Parameters::k_mic2_level,
+                                                           Parameters::k_mic2_level,
+                                                           juce::NormalisableRange<float>(CabinetBlend::silenceDecibels, 6.f, 0.1f),
+                                                           CabinetBlend::silenceDecibels));
+
+    layout.add(std::make_unique<juce::AudioParameterBool>(Parameters::k_mic2_invert,
+                                                          Parameters::k_mic2_invert,
+                                                          false));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(Parameters::k_mic2_offset,
+                                                           Parameters::k_mic2_offset,
+                                                           juce::NormalisableRange<float>(0.f, 5.f, 0.01f),
+                                                           0.f));
+
+    // Last, so the host's indices of the others stay the same
+    layout.add(std::make_unique<juce::AudioParameterBool>(Parameters::k_bypass,
+                                                          Parameters::k_bypass,
+                                                          false));
+
     return layout;
 }
 
 juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> SoftClippingPreampAudioProcessor::makeClipperLowPass()
 {
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(350.484f, getSampleRate(), 1);
+    juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> sections;
+    sections.add(designClipperLowPass().toCoefficients());
+    return sections;
 }
 
 juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> SoftClippingPreampAudioProcessor::makeLowPass2(const Settings& settings)
 {
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(settings.low_pass_freq, getSampleRate(), 1);
+    juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> sections;
+    sections.add(designLowPass2(settings).toCoefficients());
+    return sections;
 }
 
 Coefficients SoftClippingPreampAudioProcessor::makeHighShelf(const Settings& settings)
 {
-    return juce::dsp::IIR::Coefficients<float>::makeHighShelf(getSampleRate(), settings.high_shelf_freq, settings.high_shelf_q, juce::Decibels::gainToDecibels(settings.high_shelf_gain));
+    return designHighShelf(settings).toCoefficients();
+}
+
+juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> SoftClippingPreampAudioProcessor::makeToneStackFilter(const Settings& settings)
+{
+    juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> sections;
+
+    for (auto& section : designToneStack(settings))
+        sections.add(section.toCoefficients());
+
+    return sections;
 }
 
-Coefficients SoftClippingPreampAudioProcessor::makeToneStackFilter(const Settings& settings)
+namespace
+{
+    // The first order Butterworth juce::dsp::FilterDesign makes for order 1, in float like it
+    SectionDesign designFirstOrderHighPass(float frequency, double sampleRate) noexcept
+    {
+        auto n = std::tan(juce::MathConstants<float>::pi * frequency / (float)sampleRate);
+        return SectionDesign::firstOrder(1.f, -1.f, n + 1.f, n - 1.f);
+    }
+}
+
+SectionDesign SoftClippingPreampAudioProcessor::designClipperLowPass() const noexcept
+{
+    return designFirstOrderHighPass(350.484f, getSampleRate());
+}
+
+SectionDesign SoftClippingPreampAudioProcessor::designLowPass2(const Settings& settings) const noexcept
+{
+    return designFirstOrderHighPass(settings.low_pass_freq, getSampleRate());
+}
+
+// juce::dsp::IIR::Coefficients::makeHighShelf, the gain argument as before
+SectionDesign SoftClippingPreampAudioProcessor::designHighShelf(const Settings& settings) const noexcept
+{
+    auto gainFactor = juce::Decibels::gainToDecibels(settings.high_shelf_gain);
+
+    auto A = juce::jmax(0.f, std::sqrt(gainFactor));
+    auto aminus1 = A - 1;
+    auto aplus1 = A + 1;
+    auto omega = (2 * juce::MathConstants<float>::pi * juce::jmax(settings.high_shelf_freq, 2.f)) / (float)getSampleRate();
+    auto coso = std::cos(omega);
+    auto beta = std::sin(omega) * std::sqrt(A) / settings.high_shelf_q;
+    auto aminus1TimesCoso = aminus1 * coso;
+
+    return SectionDesign::secondOrder(A * (aplus1 + aminus1TimesCoso + beta),
+                                      A * -2 * (aminus1 + aplus1 * coso),
+                                      A * (aplus1 + aminus1TimesCoso - beta),
+                                      aplus1 - aminus1TimesCoso + beta,
+                                      2 * (aminus1 - aplus1 * coso),
+                                      aplus1 - aminus1TimesCoso - beta);
+}
+
+std::array<SectionDesign, 2> SoftClippingPreampAudioProcessor::designToneStack(const Settings& settings) const noexcept
 {
     double l = (double)settings.low_gain;
     double m = (double)settings.middle_gain;
@@ -492,19 +1154,48 @@ Coefficients SoftClippingPreampAudioProcessor::makeToneStackFilter(const Setting
                 + m * a3_m_sum + l * c1c2c3r1r2r4
                 + c1c2c3r1r3r4;
 
-    double B0 = -b1 * c - b2 * c * c - b3 * c * c * c;
-    double B1 = -b1 * c + b2 * c * c + 3 * b3 * c * c * c;
-    double B2 = b1 * c + b2 * c * c - 3 * b3 * c * c * c;
-    double B3 = b1 * c - b2 * c * c + b3 * c * c * c;
+    // https://ccrma.stanford.edu/~dtyeh/papers/yeh06_dafx.pdf Page 2
+    // H(s) = (b1 s + b2 s^2 + b3 s^3) / (a0 + a1 s + a2 s^2 + a3 s^3)
+    //
+    // As one third order filter this loses too much in float at high rates, the poles crowd around z = 1.
+    // The denominator gets factored into (1 + tau s) (1 + alpha s + beta s^2) here in double, and the
+    // two factors are discretised on their own: s tau / (1 + tau s), a first order high pass, and
+    // (b1 + b2 s + b3 s^2) / tau / (1 + alpha s + beta s^2).
+    auto cubic = [=] (double s) { return ((a3 * s + a2) * s + a1) * s + a0; };
 
-    double A0 = -a0 - a1 * c - a2 * c * c - a3 * c * c * c;
-    double A1 = -3 * a0 - a1 * c + a2 * c * c + 3 * a3 * c * c * c;
-    double A2 = -3 * a0 + a1 * c + a2 * c * c - 3 * a3 * c * c * c;
-    double A3 = -a0 + a1 * c - a2 * c * c + a3 * c * c * c;
+    // All the coefficients are positive, so there is a real root below zero. Bracket it and bisect.
+    double lo = -1.0, hi = 0.0;
 
-    // https://ccrma.stanford.edu/~dtyeh/papers/yeh06_dafx.pdf Page 2
+    while (cubic(lo) > 0 && lo > -1.0E12)
+        lo *= 2;
+
+    for (int i = 0; i < 200 && hi - lo > -lo * 1.0E-15; ++i)
+    {
+        auto mid = 0.5 * (lo + hi);
+        (cubic(mid) > 0 ? hi : lo) = mid;
+    }
+
+    double tau = -1.0 / (0.5 * (lo + hi));
+    double alpha = a1 - tau;
+    double beta = a3 / tau;
+
+    // Bilinear transform of (n0 + n1 s + n2 s^2) / (d0 + d1 s + d2 s^2), normalised in double
+    auto bilinear = [c] (double n0, double n1, double n2, double d0, double d1, double d2) {
+        double A0 = d0 + d1 * c + d2 * c * c;
 
-    return *new juce::dsp::IIR::Coefficients<float>((float)B0, (float)B1, (float)B2, (float)B3, (float)A0, (float)A1, (float)A2, (float)A3);
+        return SectionDesign::secondOrder((float)((n0 + n1 * c + n2 * c * c) / A0),
+                                          (float)((2 * n0 - 2 * n2 * c * c) / A0),
+                                          (float)((n0 - n1 * c + n2 * c * c) / A0),
+                                          1.f,
+                                          (float)((2 * d0 - 2 * d2 * c * c) / A0),
+                                          (float)((d0 - d1 * c + d2 * c * c) / A0));
+    };
+
+    // s tau / (1 + tau s) -> tau c (1 - z^-1) / ((1 + tau c) + (1 - tau c) z^-1)
+    double A0 = 1 + tau * c;
+
+    return { bilinear(b1 / tau, b2 / tau, b3 / tau, a0, alpha, beta),
+             SectionDesign::firstOrder((float)(tau * c / A0), (float)(-tau * c / A0), 1.f, (float)((1 - tau * c) / A0)) };
 }
 
 void SoftClippingPreampAudioProcessor::makeAmplification(const Settings& settings, const ChainPositions pos)
@@ -533,18 +1224,23 @@ void SoftClippingPreampAudioProcessor::makeAmplification(const Settings& setting
 
 void SoftClippingPreampAudioProcessor::makeWaveShaper(const Settings& settings)
 {
-    leftProcessChain.get<ChainPositions::Clipping>().functionToUse = [&settings] (float x) {
-        return ( (2.f / juce::MathConstants<float>::pi) * std::atan(settings.drive * x) ) + x;
-    };
-    rightProcessChain.get<ChainPositions::Clipping>().functionToUse = [&settings](float x) {
-        return ( (2.f / juce::MathConstants<float>::pi) * std::atan(settings.drive * x) ) + x;
-    };
+    for (auto* clipper : { &leftProcessChain.get<ChainPositions::Clipping>(), &rightProcessChain.get<ChainPositions::Clipping>() })
+    {
+        clipper->setType((ClipperType)settings.clipper_type);
+        clipper->setDrive(settings.drive);
+        clipper->setAntiderivativeAntialiasing(settings.clipper_adaa);
+        clipper->setNumStages(settings.gain_stages);
+        clipper->setStageDrive(settings.stage_drive);
+    }
 }
 
 void SoftClippingPreampAudioProcessor::makeConvolutionFilter(const Settings& settings)
 {
+    auto blend = makeBlend(settings);
 
     if (irLoaded.compareAndSetBool(true, false)) {
+        TRACE_INSTANCE_SCOPE("Impulse response load", deadlineMonitor.getInstanceNumber());
+
         auto dir = juce::File::getCurrentWorkingDirectory();
 
         int numTries = 0;
@@ -552,22 +1248,323 @@ void SoftClippingPreampAudioProcessor::makeConvolutionFilter(const Settings& set
         while (!dir.getChildFile("Resources").exists() && numTries++ < 15)
             dir = dir.getParentDirectory();
 
-        auto& leftConvolution = leftProcessChain.template get<ChainPositions::Cabinet>();
-        auto& rightConvolution = rightProcessChain.template get<ChainPositions::Cabinet>();
-        leftConvolution.loadImpulseResponse(dir.getChildFile("Resources").getChildFile("Mesa Boogie Mark V.wav"),
-                                            juce::dsp::Convolution::Stereo::no,
-                                            juce::dsp::Convolution::Trim::no,
-                                            0);
-        rightConvolution.loadImpulseResponse(dir.getChildFile("Resources").getChildFile("Mesa Boogie Mark V.wav"),
-                                             juce::dsp::Convolution::Stereo::no,
-                                             juce::dsp::Convolution::Trim::no,
-                                             0);
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        // Mic 1 is the Mark V, mic 2 the next response in Resources, or the same one again
+        auto resources = dir.getChildFile("Resources");
+        auto files = resources.findChildFiles(juce::File::findFiles, false, "*.wav");
+        files.sort();
+
+        juce::Array<juce::File> micFiles { resources.getChildFile("Mesa Boogie Mark V.wav") };
+
+        for (auto& file : files)
+            if (file != micFiles[0] && micFiles.size() < CabinetBlend::maxMics)
+                micFiles.add(file);
+
+        while (micFiles.size() < CabinetBlend::maxMics)
+            micFiles.add(micFiles[0]);
+
+        juce::AudioBuffer<float> response;
+        double responseSampleRate = 0;
+
+        for (int i = 0; i < CabinetBlend::maxMics; ++i)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(micFiles[i]));
+
+            if (reader != nullptr)
+            {
+                response.setSize(1, (int)reader->lengthInSamples);
+                reader->read(&response, 0, (int)reader->lengthInSamples, 0, true, false);
+                responseSampleRate = reader->sampleRate;
+            }
+            else if (i == 0)
+            {
+                return;
+            }
+
+            cabinetBlend.setMicResponse(i, response, responseSampleRate);
+        }
+
+        // The first mix is needed right away
+        requestedBlend = blend;
+        loadCabinetResponse(cabinetBlend.bake(blend));
+        return;
+    }
+
+    if (blend != requestedBlend)
+    {
+        requestedBlend = blend;
+        cabinetBlend.requestBake(blend);
+    }
+}
+
+CabinetBlend::Blend SoftClippingPreampAudioProcessor::makeBlend(const Settings& settings)
+{
+    CabinetBlend::Blend blend;
+
+    blend[0] = { settings.mic1_level, settings.mic1_invert, settings.mic1_offset };
+    blend[1] = { settings.mic2_level, settings.mic2_invert, settings.mic2_offset };
+
+    return blend;
+}
+
+void SoftClippingPreampAudioProcessor::loadCabinetResponse(const juce::AudioBuffer<float>& response)
+{
+    TRACE_INSTANCE_SCOPE("Cabinet response load", deadlineMonitor.getInstanceNumber());
+
+    // Both crossfade from the response they had
+    leftProcessChain.get<ChainPositions::Cabinet>().loadImpulseResponse(response, cabinetBlend.getSampleRate());
+    rightProcessChain.get<ChainPositions::Cabinet>().loadImpulseResponse(response, cabinetBlend.getSampleRate());
+}
+
+void SoftClippingPreampAudioProcessor::makeQuality(const Settings& settings)
+{
+    auto quality = renderingOffline ? Quality::High : (Quality)settings.quality;
+    auto& tier = QualitySettings::get(quality);
+
+    for (auto* clipper : { &leftProcessChain.get<ChainPositions::Clipping>(), &rightProcessChain.get<ChainPositions::Clipping>() })
+    {
+        // takes over in switchOversampling, once the host knows its latency
+        clipper->prepareOversamplingOrder(tier.oversamplingOrder);
+        clipper->setUseApproximations(tier.useApproximations);
+        clipper->setDiodeNewtonIterations(tier.diodeNewtonIterations);
+    }
+
+    smoothingInterval = tier.smoothingInterval;
+
+    // the reported latency and the cabinet length follow on the message thread
+    if (appliedQuality.exchange((int)quality) != (int)quality)
+        triggerAsyncUpdate();
+}
+
+void SoftClippingPreampAudioProcessor::switchOversampling()
+{
+    auto& left = leftProcessChain.get<ChainPositions::Clipping>();
+    auto order = left.getPreparedOversamplingOrder();
+
+    if (order == left.getOversamplingOrder())
+        return;
+
+    // Offline the host doesn't compensate as it goes, and may not get to the message thread
+    if (! renderingOffline && reportedOversamplingOrder.load() != order)
+        return;
+
+    left.switchToPreparedOrder();
+    rightProcessChain.get<ChainPositions::Clipping>().switchToPreparedOrder();
+}
+
+void SoftClippingPreampAudioProcessor::makeCabinet(const Settings& settings)
+{
+    leftProcessChain.get<ChainPositions::Cabinet>().setLightMode(settings.light_cabinet);
+    rightProcessChain.get<ChainPositions::Cabinet>().setLightMode(settings.light_cabinet);
+
+    // Moving the tail between threads allocates, the message thread does it
+    if (settings.threaded_cabinet != leftProcessChain.get<ChainPositions::Cabinet>().isThreadedTail())
+        triggerAsyncUpdate();
+
+    // So does baking a new mic blend
+    if (makeBlend(settings) != makeBlend(activeSettings))
+        triggerAsyncUpdate();
+}
+
+std::unique_ptr<DspSnapshot> SoftClippingPreampAudioProcessor::makeSnapshot(const Settings& settings)
+{
+    TRACE_INSTANCE_SCOPE("Snapshot design", deadlineMonitor.getInstanceNumber());
+
+    auto snapshot = std::make_unique<DspSnapshot>();
+
+    snapshot->settings = settings;
+    snapshot->sampleRate = getSampleRate();
+    snapshot->lowPass = makeClipperLowPass()[0];
+    snapshot->lowPass2 = makeLowPass2(settings)[0];
+    snapshot->highShelf = makeHighShelf(settings);
+    snapshot->toneStack = makeToneStackFilter(settings);
+
+    return snapshot;
+}
+
+void SoftClippingPreampAudioProcessor::applySnapshot(const DspSnapshot& snapshot)
+{
+    TRACE_INSTANCE_SCOPE("Snapshot apply", deadlineMonitor.getInstanceNumber());
+
+    // a restored state or a program doesn't glide
+    smoother.setCurrentAndTarget(snapshot.settings);
+
+    // Designed before the last prepareToPlay, the coefficients are for the wrong rate
+    if (snapshot.sampleRate != getSampleRate())
+    {
+        updateChain(snapshot.settings);
+        return;
     }
+
+    makeAmplification(snapshot.settings, ChainPositions::Input);
+
+    makeWaveShaper(snapshot.settings);
+    makeQuality(snapshot.settings);
+
+    updateFilters(snapshot.lowPass, snapshot.lowPass2, snapshot.highShelf, snapshot.toneStack);
+    resetToneStack();
+
+    makeAmplification(snapshot.settings, ChainPositions::Volume);
+    makeAmplification(snapshot.settings, ChainPositions::Output);
+
+    makeCabinet(snapshot.settings);
+
+    activeSettings = snapshot.settings;
 }
 
-void SoftClippingPreampAudioProcessor::updateCoefficients(Coefficients& old, const Coefficients& replacements)
+void SoftClippingPreampAudioProcessor::updateChain(const Settings& settings)
 {
-    *old = *replacements;
+    TRACE_INSTANCE_SCOPE("Coefficient redesign", deadlineMonitor.getInstanceNumber());
+
+    makeAmplification(settings, ChainPositions::Input);
+
+    makeWaveShaper(settings);
+    makeQuality(settings);
+
+    // While a parameter glides this runs every smoothingInterval samples, designed by value
+    updateFilters(settings);
+    leftProcessChain.get<ChainPositions::ToneFilters>().setBypassed(ToneFilterSections::HighShelf, true);
+    rightProcessChain.get<ChainPositions::ToneFilters>().setBypassed(ToneFilterSections::HighShelf, true);
+
+    makeAmplification(settings, ChainPositions::Volume);
+
+    makeAmplification(settings, ChainPositions::Output);
+
+    makeCabinet(settings);
+
+    activeSettings = settings;
+}
+
+void SoftClippingPreampAudioProcessor::publishProgramSnapshots()
+{
+    TRACE_INSTANCE_SCOPE("Program snapshots", deadlineMonitor.getInstanceNumber());
+
+    if (getSampleRate() <= 0)
+        return;
+
+    auto programs = std::make_unique<ProgramSnapshots>();
+
+    for (int i = 0; i < programBank.size(); ++i)
+        programs->snapshots.add(makeSnapshot(getSettings(programBank[i].state)));
+
+    programPublisher.publish(std::move(programs));
+}
+
+void SoftClippingPreampAudioProcessor::applyPendingProgram(const juce::MidiBuffer& midiMessages)
+{
+    auto* programs = programPublisher.beginRead();
+    auto numPrograms = programs != nullptr ? programs->snapshots.size() : 0;
+
+    for (const auto metadata : midiMessages)
+    {
+        auto message = metadata.getMessage();
+
+        if (message.isProgramChange() && juce::isPositiveAndBelow(message.getProgramChangeNumber(), numPrograms))
+        {
+            pendingProgram.store(message.getProgramChangeNumber());
+            currentProgram.store(message.getProgramChangeNumber());
+            programChangePending.store(true);
+            triggerAsyncUpdate();
+        }
+    }
+
+    auto index = pendingProgram.exchange(-1);
+
+    if (juce::isPositiveAndBelow(index, numPrograms))
+    {
+        applySnapshot(*programs->snapshots.getUnchecked(index));
+
+        // the parameters still hold the old values, see processBlock
+        observedSettings = getControlledSettings();
+    }
+
+    programPublisher.endRead();
+}
+
+void SoftClippingPreampAudioProcessor::handleAsyncUpdate()
+{
+    auto index = currentProgram.load();
+
+    if (programChangePending.exchange(false) && juce::isPositiveAndBelow(index, programBank.size()))
+    {
+        auto state = programBank[index].state.createCopy();
+        state.setProperty("program", index, nullptr);
+
+        // a program doesn't bypass the plugin or release its bypass
+        auto bypass = state.getChildWithProperty("id", Parameters::k_bypass);
+
+        if (bypass.isValid())
+            bypass.setProperty("value", m_apvts.getRawParameterValue(Parameters::k_bypass)->load(), nullptr);
+        m_apvts.replaceState(state);
+    }
+
+    auto settings = getSettings();
+    auto threaded = settings.threaded_cabinet;
+    auto& tier = QualitySettings::get((Quality)appliedQuality.load());
+
+    for (auto* cabinet : { &leftProcessChain.get<ChainPositions::Cabinet>(), &rightProcessChain.get<ChainPositions::Cabinet>() })
+    {
+        cabinet->setThreadedTail(threaded);
+        cabinet->setMaximumLength(tier.cabinetSeconds);
+    }
+
+    setLatencySamples(juce::roundToInt(leftProcessChain.get<ChainPositions::Clipping>().getLatencyInSamples(tier.oversamplingOrder)));
+    reportedOversamplingOrder.store(tier.oversamplingOrder);
+
+    // Asks for the blend the parameters have now, and loads a mix that got baked
+    makeConvolutionFilter(settings);
+
+    juce::AudioBuffer<float> response;
+
+    if (cabinetBlend.takeBaked(response))
+        loadCabinetResponse(response);
+}
+
+void SoftClippingPreampAudioProcessor::updateFilters(const Coefficients& lowPass, const Coefficients& lowPass2,
+                                                     const Coefficients& highShelf,
+                                                     const juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>>& toneStack)
+{
+    // Copied into the chains' own storage, which never reallocates
+    for (auto* chain : { &leftProcessChain, &rightProcessChain })
+    {
+        chain->get<ChainPositions::LowPass>().setCoefficients(0, *lowPass);
+
+        auto& filters = chain->get<ChainPositions::ToneFilters>();
+        filters.setCoefficients(ToneFilterSections::LowPass2, *lowPass2);
+        filters.setCoefficients(ToneFilterSections::HighShelf, *highShelf);
+        filters.setCoefficients(ToneFilterSections::ToneStack, *toneStack[0]);
+        filters.setCoefficients(ToneFilterSections::ToneStackHighPass, *toneStack[1]);
+    }
+}
+
+void SoftClippingPreampAudioProcessor::updateFilters(const Settings& settings) noexcept
+{
+    auto lowPass = designClipperLowPass();
+    auto lowPass2 = designLowPass2(settings);
+    auto highShelf = designHighShelf(settings);
+    auto toneStack = designToneStack(settings);
+
+    for (auto* chain : { &leftProcessChain, &rightProcessChain })
+    {
+        chain->get<ChainPositions::LowPass>().setCoefficients(0, lowPass);
+
+        auto& filters = chain->get<ChainPositions::ToneFilters>();
+        filters.setCoefficients(ToneFilterSections::LowPass2, lowPass2);
+        filters.setCoefficients(ToneFilterSections::HighShelf, highShelf);
+        filters.setCoefficients(ToneFilterSections::ToneStack, toneStack[0]);
+        filters.setCoefficients(ToneFilterSections::ToneStackHighPass, toneStack[1]);
+    }
+}
+
+void SoftClippingPreampAudioProcessor::resetToneStack()
+{
+    for (auto* chain : { &leftProcessChain, &rightProcessChain })
+    {
+        chain->get<ChainPositions::ToneFilters>().reset(ToneFilterSections::ToneStack);
+        chain->get<ChainPositions::ToneFilters>().reset(ToneFilterSections::ToneStackHighPass);
+    }
 }
 
 //==============================================================================
@@ -9,26 +9,35 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "DspState.h"
+#include "ProgramBank.h"
+#include "ClipperCascade.h"
+#include "CabinetConvolution.h"
+#include "CabinetBlend.h"
+#include "AnalyserFifo.h"
+#include "MidiControllerMap.h"
+#include "Quality.h"
+#include "SettingsSmoother.h"
+#include "FilterCascade.h"
+#include "FusedKernel.h"
+#include "LevelMeter.h"
+#include "DeadlineMonitor.h"
+#include "WorkerPool.h"
+#include "Trace.h"
 
 //==============================================================================
 /**
 */
 
-using Filter = juce::dsp::IIR::Filter<float>;
-using Coefficients = Filter::CoefficientsPtr;
+using Coefficients = juce::dsp::IIR::Coefficients<float>::Ptr;
 using Gain = juce::dsp::Gain<float>;
-using Dist = juce::dsp::WaveShaper<float, std::function<float(float)>>;
-using Convolution = juce::dsp::Convolution;
+using Dist = ClipperCascade;
+using Convolution = CabinetConvolution;
+using Tap = AnalyserTap;
 
-struct Settings
-{
-    float low_gain { 0 }, middle_gain { 0 }, treble_gain { 0 };
-    float low_pass_freq { 0 }, high_shelf_freq { 0 }, high_shelf_gain { 0 }, high_shelf_q { 0 };
-    float drive { 0 }, volume { 0 };
-    float input_level { 0 }, output_level { 0 };
-};
-
-class SoftClippingPreampAudioProcessor  : public juce::AudioProcessor
+class SoftClippingPreampAudioProcessor  : public juce::AudioProcessor,
+                                          private juce::AsyncUpdater,
+                                          private juce::Timer
 {
 public:
     //==============================================================================
@@ -45,6 +54,9 @@ public:
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    // The Bypass parameter, which crossfades to the input delayed by the latency instead of the host bypassing
+    juce::AudioProcessorParameter* getBypassParameter() const override;
+
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -69,39 +81,237 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
 
     Settings getSettings();
+    Settings getSettings(const juce::ValueTree& state);
+
+    // Replaces the program bank with the presets in a directory and designs their snapshots
+    int loadProgramsFromDirectory(const juce::File& directory);
+
+    // Fed from the left channel while an editor shows them
+    struct Analysers
+    {
+        AnalyserFifo preClipper, postClipper, output;
+    };
+
+    Analysers& getAnalysers() noexcept { return analysers; }
+
+    // Both channels, measured in the passes that run anyway: the input before Input, either side of
+    // Clipping (preClipper with the clipper's activity) and after Output. Any thread reads them.
+    struct Meters
+    {
+        LevelMeter input, preClipper, postClipper, output;
+    };
+
+    const Meters& getMeters() const noexcept { return meters; }
+
+    // processBlock's time against each block's real-time budget, realtime callbacks only
+    DeadlineMonitor& getDeadlineMonitor() noexcept { return deadlineMonitor; }
+
+    // The post clipper filter designs, the editor draws their response too
+    juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeLowPass2(const Settings&);
+    Coefficients makeHighShelf(const Settings&);
+    juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeToneStackFilter(const Settings& settings);
+    bool isHighShelfEnabled() const noexcept { return ! leftProcessChain.get<ChainPositions::ToneFilters>().isBypassed(ToneFilterSections::HighShelf); }
+
+    // Every filter design for a set of settings at the current rate, for the chains here or a BatchEngine
+    std::unique_ptr<DspSnapshot> makeSnapshot(const Settings& settings);
+
+    // The mic blend the settings ask for, baked from the responses prepareToPlay loaded
+    juce::AudioBuffer<float> makeCabinetResponse(const Settings& settings)  { return cabinetBlend.bake(makeBlend(settings)); }
+    double getCabinetSampleRate() const                                    { return cabinetBlend.getSampleRate(); }
 
     static juce::AudioProcessorValueTreeState::ParameterLayout CreateParameterLayout();
     juce::AudioProcessorValueTreeState m_apvts{ *this, nullptr, "Parameters", CreateParameterLayout() };
 
+    // Offline, the right chain of a block of parallelBlockSize samples or more runs on the WorkerPool
+    // while this thread runs the left one. On by default.
+    static constexpr size_t parallelBlockSize = 2048;
+    void setParallelOfflineChannels(bool shouldRunInParallel) noexcept { parallelOfflineChannels.store(shouldRunInParallel); }
+
+    // MIDI CCs that move parameters, applied at the sample they arrive on
+    MidiControllerMap midiControllers { m_apvts };
+
 private:
     juce::Atomic<bool> irLoaded { false };
 
+    // The mics on the cabinet, mixed into the response both Cabinet positions run.
+    // Message thread: the blend asked for last.
+    CabinetBlend cabinetBlend { [this] { triggerAsyncUpdate(); } };
+    CabinetBlend::Blend requestedBlend;
+
     enum ChainPositions 
     {
         Input,
         LowPass,
+        PreClipperTap,
         Clipping,
-        LowPass2,
-        HighShelf,
-        ToneStack,
+        PostClipperTap,
+        ToneFilters,
         Volume,
         Cabinet,
-        Output
+        Output,
+        OutputTap
     };
 
-    using ProcessChain = juce::dsp::ProcessorChain<Gain, Filter, Dist, Filter, Filter, Filter, Gain, Convolution, Gain>;
+    // The sections of the ToneFilters position, run in this order
+    enum ToneFilterSections
+    {
+        LowPass2,
+        HighShelf,
+        ToneStack,          // the tone stack's second order factor
+        ToneStackHighPass   // and its first order one
+    };
+
+    // The filters' coefficients and state sit inline in the chain, in two runs: LowPass's one section
+    // and ToneFilters' four, with the clipper in between. The juce::dsp::IIR::Filters reached each
+    // section's design, its coefficients and its state through separate heap blocks. "layout" in the
+    // benchmarks counts the cache lines both take and times them. The channels keep separate chains,
+    // so dual mono can leave the right one idle.
+    using ProcessChain = juce::dsp::ProcessorChain<Gain, FilterCascade<1>, Tap, Dist, Tap, FilterCascade<4>, Gain, Convolution, Gain, Tap>;
     
+    Analysers analysers;
+    DeadlineMonitor deadlineMonitor;
+    Meters meters;
+
+    // Audio thread only: what this block's passes measured, per chain so the worker running the right
+    // one writes to its own. Cleared at the start of every block and pushed to meters at the end.
+    struct ChainLevels
+    {
+        LevelSums preClipper, postClipper, output;
+    };
+
+    LevelSums inputLevels;
+    ChainLevels leftLevels, rightLevels;
+
     ProcessChain leftProcessChain, rightProcessChain;
 
+    // State restores are designed on the message thread and handed to the audio thread here
+    DspStatePublisher statePublisher;
+    juce::uint64 appliedGeneration { 0 };
+
+    // Message thread side of the programs, and their designed snapshots for the audio thread
+    ProgramBank programBank;
+    SnapshotPublisher<ProgramSnapshots> programPublisher;
+    std::atomic<int> pendingProgram { -1 }, currentProgram { 0 };
+    std::atomic<bool> programChangePending { false };
+
+    // Audio thread only: the parameter values seen on the last block, and the ones the chain is currently designed for
+    Settings observedSettings, activeSettings;
+
+    // A mapped CC's value, normalised like the parameter's
+    struct ControllerValue
+    {
+        juce::RangedAudioParameter* parameter { nullptr };
+        float value { 0 };
+        juce::uint32 sequence { 0 };
+    };
+
+    // Audio thread only: the CCs the settings follow ahead of their parameters, one per parameter. Each
+    // stays until the message thread acknowledges having set the parameter, or waits here unsent while
+    // controllerFifo is full.
+    struct PendingController : ControllerValue
+    {
+        bool sent { false };
+    };
+
+    std::array<PendingController, MidiControllerMap::numControllers> pendingControllers;
+    int numPendingControllers { 0 };
+    juce::uint32 controllerSequence { 0 };
+
+    // The audio thread hands the CCs to the message thread here, which sets the parameters so the host
+    // and the editor follow, and stores the last sequence it set in acknowledgedController
+    static constexpr int controllerFifoSize = 256;
+    juce::AbstractFifo controllerFifo { controllerFifoSize };
+    std::array<ControllerValue, controllerFifoSize> controllerChanges;
+    std::atomic<juce::uint32> acknowledgedController { 0 };
+
+    // Audio thread only: glides activeSettings towards observedSettings, redesigning every smoothingInterval samples
+    SettingsSmoother smoother;
+    int smoothingInterval { 64 };
+    bool renderingOffline { false };
+
+    // Audio thread only: dual mono. Once both inputs have been bit identical for a while, only the left
+    // chain runs and its output is copied. When they differ again, the right chain takes over the left
+    // one's state and monoMix fades the right output back to it.
+    juce::SmoothedValue<float> monoMix;
+    int identicalSamples { 0 }, dualMonoHoldSamples { 0 };
+
+    // Audio thread only: bypassMix fades from the chains to dryBuffer, the input delayed by the chains' latency.
+    // Fully bypassed the chains don't run at all, and start again from silence when the bypass is released.
+    juce::SmoothedValue<float> bypassMix;
+    juce::AudioBuffer<float> dryBuffer, dryHistory;
+    int dryWritePosition { 0 };
+    bool chainsIdle { false };
+
+    // Audio thread only: runs the right chain on a worker, see setParallelOfflineChannels
+    struct ChannelJob : public WorkerPool::Job
+    {
+        SoftClippingPreampAudioProcessor* owner { nullptr };
+        ProcessChain* chain { nullptr };
+        juce::dsp::AudioBlock<float> block;
+
+        void run() noexcept override
+        {
+            TRACE_SCOPE("Right chain");
+            owner->processChain(*chain, block);
+        }
+    };
+
+    ChannelJob channelJob;
+
+   #if SOFTCLIPPINGPREAMP_TRACE
+    juce::SharedResourcePointer<Trace::Writer> traceWriter;
+   #endif
+    std::atomic<bool> parallelOfflineChannels { true };
+    juce::SharedResourcePointer<WorkerPool> workerPool;
+
+    // The tier the audio thread asked for, the message thread matches the latency and the cabinet to it.
+    // A new oversampling factor only takes over once its latency has been reported, in the same block
+    // the dry delay moves to it.
+    std::atomic<int> appliedQuality { (int)Quality::Standard };
+    std::atomic<int> reportedOversamplingOrder { -1 };
+
     juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeClipperLowPass();
-    juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeLowPass2(const Settings&);
-    Coefficients makeHighShelf(const Settings&);
-    Coefficients makeToneStackFilter(const Settings& settings);
+
+    // The same designs by value, which don't allocate, for redesigns on the audio thread
+    SectionDesign designClipperLowPass() const noexcept;
+    SectionDesign designLowPass2(const Settings& settings) const noexcept;
+    SectionDesign designHighShelf(const Settings& settings) const noexcept;
+    std::array<SectionDesign, 2> designToneStack(const Settings& settings) const noexcept;
+
     void makeAmplification(const Settings& settings, const ChainPositions pos);
     void makeWaveShaper(const Settings& settings);
     void makeConvolutionFilter(const Settings& settings);
+    void makeCabinet(const Settings& settings);
+    static CabinetBlend::Blend makeBlend(const Settings& settings);
+    void loadCabinetResponse(const juce::AudioBuffer<float>& response);
+    void makeQuality(const Settings& settings);
+    void switchOversampling();
+
+    void applySnapshot(const DspSnapshot& snapshot);
+    void updateChain(const Settings& settings);
+    void updateFromParameters();
+    Settings getControlledSettings();
+    void applyController(juce::RangedAudioParameter* parameter, float normalisedValue) noexcept;
+    void sendControllers() noexcept;
+    void sendController(PendingController& controller) noexcept;
+    void timerCallback() override;
+    void processSegment(juce::dsp::AudioBlock<float>& block, size_t start, size_t end);
+    void updateBypass(const juce::AudioBuffer<float>& buffer);
+    void mixBypass(juce::AudioBuffer<float>& buffer);
+    void publishMeters(int numSamples);
+    void processChannels(juce::dsp::AudioBlock<float>& block);
+    void processChain(ProcessChain& chain, juce::dsp::AudioBlock<float>& block);
+    void processBothChains(juce::dsp::AudioBlock<float>& leftBlock, juce::dsp::AudioBlock<float>& rightBlock);
+    static void copyChainState(ProcessChain& from, ProcessChain& to) noexcept;
+
+    void publishProgramSnapshots();
+    void applyPendingProgram(const juce::MidiBuffer& midiMessages);
+    void handleAsyncUpdate() override;
 
-    void updateCoefficients(Coefficients& old, const Coefficients& replacements);
+    void updateFilters(const Coefficients& lowPass, const Coefficients& lowPass2, const Coefficients& highShelf,
+                       const juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>>& toneStack);
+    void updateFilters(const Settings& settings) noexcept;
+    void resetToneStack();
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SoftClippingPreampAudioProcessor)
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    ProgramBank.cpp
+    Created: 19 Oct 2026 11:02:36am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "ProgramBank.h"
+
+const char* ProgramBank::fileExtension = ".scpreset";
+
+juce::File ProgramBank::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                .getChildFile(JucePlugin_Name)
+                .getChildFile("Presets");
+}
+
+int ProgramBank::loadFromDirectory(const juce::File& directory)
+{
+    auto files = directory.findChildFiles(juce::File::findFiles, false, juce::String("*") + fileExtension);
+    files.sort();
+
+    juce::Array<Program> loaded;
+
+    for (auto& file : files)
+    {
+        if (auto xml = juce::parseXML(file))
+        {
+            auto state = juce::ValueTree::fromXml(*xml);
+
+            if (state.isValid())
+                loaded.add({ file.getFileNameWithoutExtension(), state });
+        }
+    }
+
+    auto numLoaded = loaded.size();
+
+    if (numLoaded > 0)
+        programs.swapWith(loaded);
+
+    return numLoaded;
+}
+
+bool ProgramBank::saveProgram(const juce::File& file, const Program& program) const
+{
+    if (auto xml = program.state.createXml())
+        return xml->writeTo(file.withFileExtension(fileExtension));
+
+    return false;
+}
+
+void ProgramBank::add(Program program)
+{
+    programs.add(std::move(program));
+}
+
+void ProgramBank::clear()
+{
+    programs.clear();
+}
+
+void ProgramBank::setName(int index, const juce::String& newName)
+{
+    if (juce::isPositiveAndBelow(index, programs.size()))
+        programs.getReference(index).name = newName;
+}
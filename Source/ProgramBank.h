@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    ProgramBank.h
+    Created: 19 Oct 2026 11:02:36am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspState.h"
+
+struct Program
+{
+    juce::String name;
+    juce::ValueTree state; // same layout as the processor's parameter state
+};
+
+// The programs the host sees through getNumPrograms/setCurrentProgram. Message thread only,
+// the audio thread works from the ProgramSnapshots designed out of it.
+class ProgramBank
+{
+public:
+    static const char* fileExtension;
+
+    static juce::File getDefaultDirectory();
+
+    // Replaces the bank with every preset file found in the directory, sorted by name.
+    // Returns the number of programs loaded, the bank is left unchanged if there are none.
+    int loadFromDirectory(const juce::File& directory);
+
+    bool saveProgram(const juce::File& file, const Program& program) const;
+
+    void add(Program program);
+    void clear();
+
+    int size() const noexcept { return programs.size(); }
+    const Program& operator[](int index) const noexcept { return programs.getReference(index); }
+    void setName(int index, const juce::String& newName);
+
+private:
+    juce::Array<Program> programs;
+};
+
+// Ready to apply DSP configurations for every program in the bank, one per index.
+struct ProgramSnapshots
+{
+    juce::OwnedArray<DspSnapshot> snapshots;
+    juce::uint64 generation { 0 };
+};
@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    Quality.h
+    Created: 21 Oct 2026 11:38:02am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum class Quality
+{
+    Eco,
+    Standard,
+    High
+};
+
+// Everything a quality tier decides, as one set. Standard, the default, oversamples the clipping stages
+// 4 times with the exact curves and keeps the whole cabinet response.
+struct QualitySettings
+{
+    int oversamplingOrder;          // 2^order times, for the clipping stages
+    bool useApproximations;         // vectorised atan/tanh instead of the exact curves
+    int diodeNewtonIterations;      // on top of the diode's solution table
+    double cabinetSeconds;          // impulse response length, 0 keeps all of it
+    int smoothingInterval;          // samples between redesigns while parameters glide
+
+    static const QualitySettings& get(Quality quality) noexcept
+    {
+        static const QualitySettings tiers[] =
+        {
+            { 1, true,  0, 0.1, 256 },  // Eco
+            { 2, false, 0, 0.0, 64 },   // Standard
+            { 3, false, 2, 0.0, 16 }    // High
+        };
+
+        return tiers[juce::jlimit(0, 2, (int)quality)];
+    }
+
+    static juce::StringArray getNames()     { return { "Eco", "Standard", "High" }; }
+};
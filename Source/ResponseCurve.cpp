@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+    Created: 20 Oct 2026 4:07:52pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+#include "Clippers.h"
+
+static_assert(ResponseCurve::numPoints % juce::dsp::SIMDRegister<float>::SIMDNumElements == 0, "whole registers only");
+
+ResponseCurve::ResponseCurve(int numFilters) : filters((size_t)numFilters)
+{
+    setOpaque(true);
+}
+
+void ResponseCurve::setSampleRate(double newSampleRate)
+{
+    if (newSampleRate <= 0 || newSampleRate == sampleRate)
+        return;
+
+    sampleRate = newSampleRate;
+
+    auto numVecs = (size_t)numPoints / Vec::size();
+    cosines.assign(numVecs, Vec::expand(0.f));
+    sines.assign(numVecs, Vec::expand(0.f));
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        auto frequency = minFrequency * std::pow(maxFrequency / minFrequency, (float)i / (float)(numPoints - 1));
+        auto w = juce::MathConstants<double>::twoPi * juce::jmin((double)frequency, 0.5 * sampleRate) / sampleRate;
+
+        cosines[(size_t)i / Vec::size()].set((size_t)i % Vec::size(), (float)std::cos(w));
+        sines[(size_t)i / Vec::size()].set((size_t)i % Vec::size(), (float)std::sin(w));
+    }
+
+    // every cached response was for the old rate
+    for (auto& filter : filters)
+        filter.coefficients.clear();
+}
+
+void ResponseCurve::setFilter(int index, const CoefficientsArray& sections, bool isEnabled)
+{
+    jassert(juce::isPositiveAndBelow(index, (int)filters.size()));
+
+    if (sampleRate <= 0)
+        return;
+
+    auto& filter = filters[(size_t)index];
+
+    std::vector<float> coefficients;
+
+    for (auto* section : sections)
+    {
+        coefficients.push_back((float)section->coefficients.size());
+        coefficients.insert(coefficients.end(), section->coefficients.begin(), section->coefficients.end());
+    }
+
+    if (coefficients == filter.coefficients && isEnabled == filter.enabled)
+        return;
+
+    if (coefficients != filter.coefficients)
+    {
+        filter.coefficients = std::move(coefficients);
+        evaluate(filter, sections);
+    }
+
+    filter.enabled = isEnabled;
+    buildPath();
+    repaint();
+}
+
+void ResponseCurve::evaluate(Filter& filter, const CoefficientsArray& sections) const noexcept
+{
+    std::fill(filter.decibels.begin(), filter.decibels.end(), 0.f);
+
+    for (auto* section : sections)
+    {
+        // b0..bn followed by a1..an, a0 is normalised to 1
+        auto size = (int)section->coefficients.size();
+        evaluateSection(section->coefficients.begin(), (size - 1) / 2, filter.decibels.data());
+    }
+}
+
+void ResponseCurve::evaluateSection(const float* c, int order, float* decibels) const noexcept
+{
+    const float* b = c;
+    const float* a = c + order + 1;
+
+    for (size_t v = 0; v < cosines.size(); ++v)
+    {
+        // Horner's scheme in z^-1 = cos w - j sin w, four or eight frequencies at a time
+        auto cosine = cosines[v], sine = sines[v];
+
+        auto horner = [&] (auto coefficient, Vec& re, Vec& im)
+        {
+            re = Vec::expand(coefficient(order));
+            im = Vec::expand(0.f);
+
+            for (int k = order - 1; k >= 0; --k)
+            {
+                auto nextRe = re * cosine + im * sine + Vec::expand(coefficient(k));
+                im = im * cosine - re * sine;
+                re = nextRe;
+            }
+        };
+
+        Vec numeratorRe, numeratorIm, denominatorRe, denominatorIm;
+        horner([b] (int k) { return b[k]; }, numeratorRe, numeratorIm);
+        horner([a] (int k) { return k == 0 ? 1.f : a[k - 1]; }, denominatorRe, denominatorIm);
+
+        auto power = clippers::divide(numeratorRe * numeratorRe + numeratorIm * numeratorIm,
+                                      denominatorRe * denominatorRe + denominatorIm * denominatorIm);
+
+        for (size_t i = 0; i < Vec::size(); ++i)
+            decibels[v * Vec::size() + i] += 10.f * std::log10(juce::jmax(power.get(i), 1.0e-12f));
+    }
+}
+
+void ResponseCurve::buildPath()
+{
+    path.clear();
+
+    auto width = (float)getWidth();
+    auto height = (float)getHeight();
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        auto total = 0.f;
+
+        for (auto& filter : filters)
+            if (filter.enabled && ! filter.coefficients.empty())
+                total += filter.decibels[(size_t)i];
+
+        auto x = width * (float)i / (float)(numPoints - 1);
+        auto y = juce::jmap(juce::jlimit(minDecibels, maxDecibels, total), minDecibels, maxDecibels, height, 0.f);
+
+        if (i == 0)
+            path.startNewSubPath(x, y);
+        else
+            path.lineTo(x, y);
+    }
+}
+
+void ResponseCurve::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+    g.strokePath(grid, juce::PathStrokeType(1.f));
+
+    g.setColour(juce::Colours::gold);
+    g.strokePath(path, juce::PathStrokeType(2.f));
+}
+
+void ResponseCurve::resized()
+{
+    grid.clear();
+
+    auto width = (float)getWidth();
+    auto height = (float)getHeight();
+
+    for (auto frequency : { 50.f, 100.f, 200.f, 500.f, 1000.f, 2000.f, 5000.f, 10000.f })
+    {
+        auto x = width * std::log(frequency / minFrequency) / std::log(maxFrequency / minFrequency);
+        grid.startNewSubPath(x, 0.f);
+        grid.lineTo(x, height);
+    }
+
+    for (auto decibels = minDecibels + 12.f; decibels < maxDecibels; decibels += 12.f)
+    {
+        auto y = juce::jmap(decibels, minDecibels, maxDecibels, height, 0.f);
+        grid.startNewSubPath(0.f, y);
+        grid.lineTo(width, y);
+    }
+
+    buildPath();
+}
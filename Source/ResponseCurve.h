@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 20 Oct 2026 4:07:52pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Plots the combined magnitude response of a few IIR filters in series.
+//
+// Every filter's response is cached. setFilter() compares the coefficients with the cached ones and
+// only evaluates the response again when they differ, so a knob drag costs one filter's evaluation.
+// The evaluation works on several frequencies at once, in SIMD registers.
+class ResponseCurve : public juce::Component
+{
+public:
+    using CoefficientsArray = juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>>;
+
+    static constexpr int numPoints = 256;
+    static constexpr float minFrequency = 20.f, maxFrequency = 20000.f;
+    static constexpr float minDecibels = -36.f, maxDecibels = 12.f;
+
+    explicit ResponseCurve(int numFilters);
+
+    // Message thread. A filter can be a cascade of sections, a disabled one is left out of the total.
+    void setFilter(int index, const CoefficientsArray& sections, bool isEnabled);
+    void setSampleRate(double newSampleRate);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    struct Filter
+    {
+        std::vector<float> coefficients;
+        std::vector<float> decibels = std::vector<float>(numPoints);
+        bool enabled { false };
+    };
+
+    void evaluate(Filter& filter, const CoefficientsArray& sections) const noexcept;
+    void evaluateSection(const float* coefficients, int order, float* decibels) const noexcept;
+    void buildPath();
+
+    // e^-jw of every point, numPoints / Vec::size() registers each
+    std::vector<Vec> cosines, sines;
+
+    std::vector<Filter> filters;
+    double sampleRate { 0 };
+
+    juce::Path path, grid;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponseCurve)
+};
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    SettingsSmoother.cpp
+    Created: 21 Oct 2026 11:52:40am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "SettingsSmoother.h"
+
+void SettingsSmoother::prepare(double sampleRate, double rampSeconds) noexcept
+{
+    for (auto& v : values)
+        v.reset(sampleRate, rampSeconds);
+
+    setCurrentAndTarget(target);
+}
+
+void SettingsSmoother::setTarget(const Settings& newTarget) noexcept
+{
+    target = newTarget;
+
+    for (size_t i = 0; i < numSmoothed; ++i)
+        values[i].setTargetValue(target.*smoothedMembers[i]);
+}
+
+void SettingsSmoother::setCurrentAndTarget(const Settings& settings) noexcept
+{
+    target = settings;
+
+    for (size_t i = 0; i < numSmoothed; ++i)
+        values[i].setCurrentAndTargetValue(target.*smoothedMembers[i]);
+}
+
+bool SettingsSmoother::isSmoothing() const noexcept
+{
+    return std::any_of(values.begin(), values.end(), [] (const auto& v) { return v.isSmoothing(); });
+}
+
+Settings SettingsSmoother::advance(int numSamples) noexcept
+{
+    auto settings = target;
+
+    for (size_t i = 0; i < numSmoothed; ++i)
+        settings.*smoothedMembers[i] = values[i].skip(numSamples);
+
+    return settings;
+}
@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    SettingsSmoother.h
+    Created: 21 Oct 2026 11:52:40am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspState.h"
+
+// Glides the continuous filter and drive settings towards the parameters, so that a jump on a knob
+// becomes a series of small redesigns instead of one step. Switches, choices and the levels (the
+// Gain processors ramp those themselves) go to their new value at once. Audio thread only.
+class SettingsSmoother
+{
+public:
+    void prepare(double sampleRate, double rampSeconds) noexcept;
+
+    void setTarget(const Settings& newTarget) noexcept;
+    void setCurrentAndTarget(const Settings& settings) noexcept;
+
+    bool isSmoothing() const noexcept;
+
+    // Moves on by numSamples and returns the settings to design the next numSamples for
+    Settings advance(int numSamples) noexcept;
+
+private:
+    // The smoothed members of Settings
+    static constexpr float Settings::* smoothedMembers[] =
+    {
+        &Settings::low_gain, &Settings::middle_gain, &Settings::treble_gain,
+        &Settings::low_pass_freq, &Settings::high_shelf_freq, &Settings::high_shelf_gain, &Settings::high_shelf_q,
+        &Settings::drive, &Settings::stage_drive
+    };
+
+    static constexpr size_t numSmoothed = sizeof(smoothedMembers) / sizeof(smoothedMembers[0]);
+
+    Settings target;
+    std::array<juce::SmoothedValue<float>, numSmoothed> values;
+};
@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+    SimdKernels.cpp
+    Created: 25 Oct 2026 9:12:40am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SimdKernels.h"
+#include "Clippers.h"
+
+static_assert(SimdKernels::numCurves == (int)ClipperType::Diode, "one kernel per vectorised curve");
+
+namespace
+{
+    // The baseline: juce::dsp::SIMDRegister, which is SSE2 or NEON, and plain loops. Exactly what
+    // the plugin ran before the wider sets were added.
+    template <typename Curve>
+    void clip(const float* input, float* output, size_t numSamples, float drive) noexcept
+    {
+        using Vec = clippers::Vec;
+        constexpr auto width = Vec::size();
+
+        // SIMDRegister only loads from aligned memory, the block's channel pointers might not be
+        alignas(Vec::SIMDRegisterSize) float lanes[width];
+        size_t i = 0;
+
+        for (; i + width <= numSamples; i += width)
+        {
+            std::copy(input + i, input + i + width, lanes);
+
+            auto x = Vec::fromRawArray(lanes);
+            auto y = Curve::process(x * drive) + x;
+
+            y.copyToRawArray(lanes);
+            std::copy(lanes, lanes + width, output + i);
+        }
+
+        for (; i < numSamples; ++i)
+            output[i] = Curve::process(drive * input[i]) + input[i];
+    }
+
+    void cascade(float* data, size_t numSamples, const float (*b)[3], const float (*a)[3], float (*s)[2], float gain,
+                 SimdKernels::Levels& input) noexcept
+    {
+        auto peak = input.peak, sumOfSquares = input.sumOfSquares;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto x = data[i];
+
+            // off the filters' critical path, it costs next to nothing
+            peak = juce::jmax(peak, std::abs(x));
+            sumOfSquares += x * x;
+
+            for (int n = 0; n < 4; ++n)
+            {
+                auto y = b[n][0] * x + s[n][0];
+
+                s[n][0] = b[n][1] * x - a[n][1] * y + s[n][1];
+                s[n][1] = b[n][2] * x - a[n][2] * y;
+
+                x = y;
+            }
+
+            data[i] = x * gain;
+        }
+
+        input.peak = peak;
+        input.sumOfSquares = sumOfSquares;
+    }
+
+    void multiply(float* data, size_t numSamples, float gain) noexcept
+    {
+        juce::FloatVectorOperations::multiply(data, gain, (int)numSamples);
+    }
+
+    void multiplyAndMeasure(float* data, size_t numSamples, float gain, SimdKernels::Levels& output) noexcept
+    {
+        using Vec = clippers::Vec;
+        constexpr auto width = Vec::size();
+
+        alignas(Vec::SIMDRegisterSize) float lanes[width];
+        auto peaks = Vec::expand(0.f), sums = Vec::expand(0.f);
+        size_t i = 0;
+
+        for (; i + width <= numSamples; i += width)
+        {
+            std::copy(data + i, data + i + width, lanes);
+
+            auto y = Vec::fromRawArray(lanes) * gain;
+            peaks = Vec::max(peaks, clippers::absolute(y));
+            sums = sums + y * y;
+
+            y.copyToRawArray(lanes);
+            std::copy(lanes, lanes + width, data + i);
+        }
+
+        // across the lanes once per block
+        peaks.copyToRawArray(lanes);
+        auto peak = juce::jmax(output.peak, *std::max_element(lanes, lanes + width));
+        auto sumOfSquares = sums.sum();
+
+        for (; i < numSamples; ++i)
+        {
+            auto y = data[i] * gain;
+            data[i] = y;
+            peak = juce::jmax(peak, std::abs(y));
+            sumOfSquares += y * y;
+        }
+
+        output.peak = peak;
+        output.sumOfSquares += sumOfSquares;
+    }
+
+    void complexMultiplyAccumulate(float* acc, const float* x, const float* h, size_t numComplex) noexcept
+    {
+        for (size_t i = 0; i < numComplex; ++i)
+        {
+            auto xr = x[2 * i], xi = x[2 * i + 1];
+            auto hr = h[2 * i], hi = h[2 * i + 1];
+            acc[2 * i] += xr * hr - xi * hi;
+            acc[2 * i + 1] += xr * hi + xi * hr;
+        }
+    }
+
+    template <int numSections>
+    void laneCascadeSections(float* frames, size_t numFrames, size_t numLanes, const float (*b)[3], const float (*a)[3], float* state, float gain) noexcept
+    {
+        using Vec = clippers::Vec;
+        constexpr auto width = Vec::size();
+
+        jassert(numLanes % width == 0);
+        jassert(juce::snapPointerToAlignment(frames, Vec::SIMDRegisterSize) == frames);
+
+        for (size_t lane = 0; lane < numLanes; lane += width)
+        {
+            Vec s[numSections][2];
+
+            for (int n = 0; n < numSections; ++n)
+                for (int k = 0; k < 2; ++k)
+                    s[n][k] = Vec::fromRawArray(state + (size_t)(n * 2 + k) * numLanes + lane);
+
+            for (size_t i = 0; i < numFrames; ++i)
+            {
+                auto* frame = frames + i * numLanes + lane;
+                auto x = Vec::fromRawArray(frame);
+
+                for (int n = 0; n < numSections; ++n)
+                {
+                    auto y = x * b[n][0] + s[n][0];
+
+                    s[n][0] = x * b[n][1] - y * a[n][1] + s[n][1];
+                    s[n][1] = x * b[n][2] - y * a[n][2];
+
+                    x = y;
+                }
+
+                (x * gain).copyToRawArray(frame);
+            }
+
+            for (int n = 0; n < numSections; ++n)
+                for (int k = 0; k < 2; ++k)
+                    s[n][k].copyToRawArray(state + (size_t)(n * 2 + k) * numLanes + lane);
+        }
+
+        for (size_t i = 0; i < (size_t)numSections * 2 * numLanes; ++i)
+            juce::dsp::util::snapToZero(state[i]);
+    }
+
+    void laneCascade(float* frames, size_t numFrames, size_t numLanes, const float (*b)[3], const float (*a)[3],
+                     float* state, int numSections, float gain) noexcept
+    {
+        switch (numSections)
+        {
+        case 1:     laneCascadeSections<1>(frames, numFrames, numLanes, b, a, state, gain); break;
+        case 2:     laneCascadeSections<2>(frames, numFrames, numLanes, b, a, state, gain); break;
+        case 3:     laneCascadeSections<3>(frames, numFrames, numLanes, b, a, state, gain); break;
+        case 4:     laneCascadeSections<4>(frames, numFrames, numLanes, b, a, state, gain); break;
+        default:    jassertfalse; break;
+        }
+    }
+
+    const SimdKernels baselineKernels { SimdKernels::Isa::baseline, "baseline",
+                                        { &clip<clippers::Atan>, &clip<clippers::Tanh>, &clip<clippers::Cubic>,
+                                          &clip<clippers::Hard>, &clip<clippers::Asymmetric> },
+                                        &cascade, &multiply, &multiplyAndMeasure, &complexMultiplyAccumulate,
+                                        clippers::Vec::size(), &laneCascade };
+
+    std::atomic<const SimdKernels*> activeKernels { nullptr };
+
+    const SimdKernels& pickKernels()
+    {
+        auto requested = juce::SystemStats::getEnvironmentVariable("SOFTCLIPPINGPREAMP_ISA", {}).trim().toLowerCase();
+
+        if (requested.isNotEmpty())
+        {
+            for (auto [name, isa] : { std::make_pair("baseline", SimdKernels::Isa::baseline),
+                                      std::make_pair("avx2", SimdKernels::Isa::avx2),
+                                      std::make_pair("avx512", SimdKernels::Isa::avx512) })
+                if (requested == name)
+                    if (auto* kernels = SimdKernels::getFor(isa))
+                        return *kernels;
+
+            // not available here, the "isa" benchmark says so
+        }
+
+        for (auto isa : { SimdKernels::Isa::avx512, SimdKernels::Isa::avx2 })
+            if (auto* kernels = SimdKernels::getFor(isa))
+                return *kernels;
+
+        return baselineKernels;
+    }
+}
+
+const SimdKernels& SimdKernels::get() noexcept
+{
+    auto* kernels = activeKernels.load(std::memory_order_acquire);
+
+    if (kernels == nullptr)
+    {
+        // Two threads picking at once pick the same
+        auto* picked = &pickKernels();
+        activeKernels.compare_exchange_strong(kernels, picked);
+        return *activeKernels.load(std::memory_order_acquire);
+    }
+
+    return *kernels;
+}
+
+const SimdKernels* SimdKernels::getFor(Isa isa) noexcept
+{
+    switch (isa)
+    {
+    case Isa::baseline: return &baselineKernels;
+    case Isa::avx2:     return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3() ? getAvx2Kernels() : nullptr;
+    case Isa::avx512:   return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasFMA3() ? getAvx512Kernels() : nullptr;
+    default:            jassertfalse; return nullptr;
+    }
+}
+
+bool SimdKernels::setActive(Isa isa) noexcept
+{
+    if (auto* kernels = getFor(isa))
+    {
+        activeKernels.store(kernels, std::memory_order_release);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    SimdKernels.h
+    Created: 25 Oct 2026 9:12:40am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+
+// The hot loops of the chain, built once for the baseline instruction set and, on x86, again for
+// AVX2 and for AVX-512. One set gets picked on first use from what the CPU has, or from
+// SOFTCLIPPINGPREAMP_ISA (baseline, avx2 or avx512) when that is set and the CPU has it.
+//
+// The wider sets use FMA, so their results differ from the baseline's in the last bits. The "isa"
+// benchmark fails when the energy of any set's difference to the baseline is above
+// maxDifferenceDecibels, relative to the baseline's. The float filters are only about 97 dB clear of
+// their exact response at 192 kHz to begin with, so rounding differently can't be held to much less.
+//
+// Deliberately free of JuceHeader.h: the AVX translation units include this with the wider
+// instruction sets enabled, and must not compile any inline function the rest of the plugin shares.
+struct SimdKernels
+{
+    enum class Isa
+    {
+        baseline,
+        avx2,
+        avx512
+    };
+
+    static constexpr int numIsas = 3;
+    static constexpr double maxDifferenceDecibels = -90.0;
+
+    // The vectorised curves of ClipperStage, in ClipperType order: atan, tanh, cubic, hard, asymmetric.
+    // output = curve(drive * input) + input, input and output may be the same.
+    static constexpr int numCurves = 5;
+    using ClipFunction = void (*)(const float* input, float* output, size_t numSamples, float drive);
+
+    // What a meter takes from a block: the largest magnitude and the sum of the squares. Kernels add
+    // to it, the larger peak and the sums together, so one can carry over several blocks or channels.
+    struct Levels
+    {
+        float peak { 0 };
+        float sumOfSquares { 0 };
+    };
+
+    // Four biquad sections in series and then a gain, in place, as FilterCascade<4>::Kernel lays them out.
+    // Measures the input on the way in.
+    using CascadeFunction = void (*)(float* data, size_t numSamples, const float (*b)[3], const float (*a)[3],
+                                     float (*state)[2], float gain, Levels& input);
+
+    using MultiplyFunction = void (*)(float* data, size_t numSamples, float gain);
+
+    // multiply, measuring the result in the same pass. The product rounds as multiply's does.
+    using MultiplyAndMeasureFunction = void (*)(float* data, size_t numSamples, float gain, Levels& output);
+
+    // acc += x * h, interleaved complex numbers as juce::dsp::FFT lays them out
+    using ComplexMultiplyAccumulateFunction = void (*)(float* acc, const float* x, const float* h, size_t numComplex);
+
+    // numLanes independent streams, interleaved a frame of numLanes samples per time step, all through
+    // the same numSections biquads and then a gain, in place. state is [section][s0, s1][numLanes].
+    // numLanes must be a multiple of laneWidth, frames and state aligned to laneWidth floats.
+    // Rounds the same way as cascade does, lane by lane.
+    static constexpr int maxLaneSections = 4;
+    using LaneCascadeFunction = void (*)(float* frames, size_t numFrames, size_t numLanes, const float (*b)[3],
+                                         const float (*a)[3], float* state, int numSections, float gain);
+
+    Isa isa;
+    const char* name;
+
+    ClipFunction clip[numCurves];
+    CascadeFunction cascade;
+    MultiplyFunction multiply;
+    MultiplyAndMeasureFunction multiplyAndMeasure;
+    ComplexMultiplyAccumulateFunction complexMultiplyAccumulate;
+
+    size_t laneWidth;
+    LaneCascadeFunction laneCascade;
+
+    // The active set. The first call picks it, make it from the message thread.
+    static const SimdKernels& get() noexcept;
+
+    // The set for an instruction set, nullptr when the build or the CPU doesn't have it
+    static const SimdKernels* getFor(Isa isa) noexcept;
+
+    // For tests and benchmarks, false when the set isn't available. Takes effect on the next block.
+    static bool setActive(Isa isa) noexcept;
+};
+
+// Defined in SimdKernelsAvx2.cpp and SimdKernelsAvx512.cpp, nullptr where those aren't built
+const SimdKernels* getAvx2Kernels() noexcept;
+const SimdKernels* getAvx512Kernels() noexcept;
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    SimdKernelsAvx2.cpp
+    Created: 25 Oct 2026 9:12:40am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "SimdKernels.h"
+
+#if defined (__x86_64__) || defined (__i386__) || defined (_M_X64) || defined (_M_IX86)
+
+// Only this file gets AVX2 and FMA, whatever the rest of the build targets. MSVC takes the
+// intrinsics without /arch.
+#if defined (__clang__)
+ #pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined (__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target ("avx2,fma")
+#endif
+
+#include "SimdKernelsX86.h"
+
+namespace
+{
+    struct Avx2
+    {
+        using Vec = __m256;
+        static constexpr size_t width = 8;
+
+        static Vec load(const float* p) noexcept            { return _mm256_loadu_ps(p); }
+        static void store(float* p, Vec v) noexcept         { _mm256_storeu_ps(p, v); }
+        static Vec expand(float s) noexcept                 { return _mm256_set1_ps(s); }
+
+        static Vec add(Vec a, Vec b) noexcept               { return _mm256_add_ps(a, b); }
+        static Vec sub(Vec a, Vec b) noexcept               { return _mm256_sub_ps(a, b); }
+        static Vec mul(Vec a, Vec b) noexcept               { return _mm256_mul_ps(a, b); }
+        static Vec div(Vec a, Vec b) noexcept               { return _mm256_div_ps(a, b); }
+        static Vec min(Vec a, Vec b) noexcept               { return _mm256_min_ps(a, b); }
+        static Vec max(Vec a, Vec b) noexcept               { return _mm256_max_ps(a, b); }
+        static Vec fma(Vec a, Vec b, Vec c) noexcept        { return _mm256_fmadd_ps(a, b, c); }
+        static Vec fnma(Vec a, Vec b, Vec c) noexcept       { return _mm256_fnmadd_ps(a, b, c); }
+
+        static Vec realParts(Vec v) noexcept                { return _mm256_moveldup_ps(v); }
+        static Vec imaginaryParts(Vec v) noexcept           { return _mm256_movehdup_ps(v); }
+        static Vec swapPairs(Vec v) noexcept                { return _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+        static Vec fmaddsub(Vec a, Vec b, Vec c) noexcept   { return _mm256_fmaddsub_ps(a, b, c); }
+    };
+
+    // Constant initialised, nothing built for this set runs before the CPU has been asked
+    constexpr SimdKernels avx2Kernels = x86::makeKernels<Avx2>(SimdKernels::Isa::avx2, "AVX2");
+}
+
+const SimdKernels* getAvx2Kernels() noexcept
+{
+    return &avx2Kernels;
+}
+
+#if defined (__clang__)
+ #pragma clang attribute pop
+#elif defined (__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#else
+
+const SimdKernels* getAvx2Kernels() noexcept
+{
+    return nullptr;
+}
+
+#endif
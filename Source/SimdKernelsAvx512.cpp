@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    SimdKernelsAvx512.cpp
+    Created: 25 Oct 2026 9:12:40am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "SimdKernels.h"
+
+#if defined (__x86_64__) || defined (__i386__) || defined (_M_X64) || defined (_M_IX86)
+
+// Only this file gets AVX-512F, and the AVX2 and FMA under it, whatever the rest of the build
+// targets. MSVC takes the intrinsics without /arch.
+#if defined (__clang__)
+ #pragma clang attribute push (__attribute__((target("avx512f,avx2,fma"))), apply_to = function)
+#elif defined (__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target ("avx512f,avx2,fma")
+#endif
+
+#include "SimdKernelsX86.h"
+
+namespace
+{
+    struct Avx512
+    {
+        using Vec = __m512;
+        static constexpr size_t width = 16;
+
+        static Vec load(const float* p) noexcept            { return _mm512_loadu_ps(p); }
+        static void store(float* p, Vec v) noexcept         { _mm512_storeu_ps(p, v); }
+        static Vec expand(float s) noexcept                 { return _mm512_set1_ps(s); }
+
+        static Vec add(Vec a, Vec b) noexcept               { return _mm512_add_ps(a, b); }
+        static Vec sub(Vec a, Vec b) noexcept               { return _mm512_sub_ps(a, b); }
+        static Vec mul(Vec a, Vec b) noexcept               { return _mm512_mul_ps(a, b); }
+        static Vec div(Vec a, Vec b) noexcept               { return _mm512_div_ps(a, b); }
+        static Vec min(Vec a, Vec b) noexcept               { return _mm512_min_ps(a, b); }
+        static Vec max(Vec a, Vec b) noexcept               { return _mm512_max_ps(a, b); }
+        static Vec fma(Vec a, Vec b, Vec c) noexcept        { return _mm512_fmadd_ps(a, b, c); }
+        static Vec fnma(Vec a, Vec b, Vec c) noexcept       { return _mm512_fnmadd_ps(a, b, c); }
+
+        static Vec realParts(Vec v) noexcept                { return _mm512_moveldup_ps(v); }
+        static Vec imaginaryParts(Vec v) noexcept           { return _mm512_movehdup_ps(v); }
+        static Vec swapPairs(Vec v) noexcept                { return _mm512_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+        static Vec fmaddsub(Vec a, Vec b, Vec c) noexcept   { return _mm512_fmaddsub_ps(a, b, c); }
+    };
+
+    // Constant initialised, nothing built for this set runs before the CPU has been asked
+    constexpr SimdKernels avx512Kernels = x86::makeKernels<Avx512>(SimdKernels::Isa::avx512, "AVX-512");
+}
+
+const SimdKernels* getAvx512Kernels() noexcept
+{
+    return &avx512Kernels;
+}
+
+#if defined (__clang__)
+ #pragma clang attribute pop
+#elif defined (__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#else
+
+const SimdKernels* getAvx512Kernels() noexcept
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,319 @@
+/*
+  ==============================================================================
+
+    SimdKernelsX86.h
+    Created: 25 Oct 2026 9:12:40am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <immintrin.h>
+#include "SimdKernels.h"
+
+// The kernels written once over a register type, for SimdKernelsAvx2.cpp and SimdKernelsAvx512.cpp.
+// Each of those enables its instruction set before including this and passes its own Ops:
+//  - Vec, width, load/store (unaligned), expand, add, sub, mul, div, min, max, fma (a * b + c),
+//    fnma (c - a * b)
+//  - realParts/imaginaryParts (each duplicated into both halves of a complex number), swapPairs,
+//    fmaddsub (a * b - c in the real lanes, a * b + c in the imaginary ones)
+//
+// Everything is in an anonymous namespace, so nothing built here can stand in for code of the
+// baseline build at link time.
+namespace
+{
+namespace x86
+{
+    // The curves of clippers:: with the same constants, only the roundings of FMA differ
+    template <typename Ops>
+    struct Curves
+    {
+        using Vec = typename Ops::Vec;
+
+        static Vec clamp(Vec x, float lo, float hi) noexcept
+        {
+            return Ops::min(Ops::max(x, Ops::expand(lo)), Ops::expand(hi));
+        }
+
+        static Vec atan(Vec u) noexcept
+        {
+            auto a = Ops::max(u, Ops::sub(Ops::expand(0.f), u));
+            auto numerator = Ops::mul(u, Ops::add(a, Ops::expand(0.63661977f)));
+            auto denominator = Ops::fma(u, u, Ops::fma(a, Ops::expand(1.27323954f), Ops::expand(1.f)));
+            return Ops::div(numerator, denominator);
+        }
+
+        static Vec tanh(Vec u) noexcept
+        {
+            auto x = clamp(u, -5.f, 5.f);
+            auto x2 = Ops::mul(x, x);
+            auto numerator = Ops::mul(x, Ops::fma(x2, Ops::fma(x2, Ops::add(x2, Ops::expand(378.f)), Ops::expand(17325.f)),
+                                                  Ops::expand(135135.f)));
+            auto denominator = Ops::fma(x2, Ops::fma(x2, Ops::fma(x2, Ops::expand(28.f), Ops::expand(3150.f)), Ops::expand(62370.f)),
+                                        Ops::expand(135135.f));
+            return clamp(Ops::div(numerator, denominator), -1.f, 1.f);
+        }
+
+        static Vec cubic(Vec u) noexcept
+        {
+            auto x = clamp(u, -1.f, 1.f);
+            return Ops::sub(Ops::mul(x, Ops::expand(1.5f)), Ops::mul(Ops::mul(x, x), Ops::mul(x, Ops::expand(0.5f))));
+        }
+
+        static Vec hard(Vec u) noexcept         { return clamp(u, -1.f, 1.f); }
+        static Vec asymmetric(Vec u) noexcept   { return clamp(u, -0.5f, 1.f); }
+    };
+
+    template <typename Ops, typename Ops::Vec (*curve)(typename Ops::Vec)>
+    void clip(const float* input, float* output, size_t numSamples, float drive) noexcept
+    {
+        auto driveVec = Ops::expand(drive);
+        size_t i = 0;
+
+        for (; i + Ops::width <= numSamples; i += Ops::width)
+        {
+            auto x = Ops::load(input + i);
+            Ops::store(output + i, Ops::add(curve(Ops::mul(x, driveVec)), x));
+        }
+
+        // The last few through a register too, so they get the same rounding as the rest
+        if (i < numSamples)
+        {
+            alignas(64) float lanes[Ops::width] = {};
+
+            for (size_t j = i; j < numSamples; ++j)
+                lanes[j - i] = input[j];
+
+            auto x = Ops::load(lanes);
+            Ops::store(lanes, Ops::add(curve(Ops::mul(x, driveVec)), x));
+
+            for (size_t j = i; j < numSamples; ++j)
+                output[j] = lanes[j - i];
+        }
+    }
+
+    // The four sections run side by side, one per lane, each a sample behind the one before it:
+    // at step t lane k works on sample t - k, with what lane k - 1 put out at step t - 1. The first
+    // and last three steps leave the lanes that have nothing to do yet, or anymore, as they were.
+    // Four lanes are all there are, so the AVX2 and AVX-512 sets both run this 128-bit code: it gains
+    // from FMA, not from their width.
+    inline void cascade(float* data, size_t numSamples, const float (*b)[3], const float (*a)[3], float (*state)[2], float gain,
+                        SimdKernels::Levels& input) noexcept
+    {
+        constexpr int numLanes = 4;
+
+        auto b0 = _mm_setr_ps(b[0][0], b[1][0], b[2][0], b[3][0]);
+        auto b1 = _mm_setr_ps(b[0][1], b[1][1], b[2][1], b[3][1]);
+        auto b2 = _mm_setr_ps(b[0][2], b[1][2], b[2][2], b[3][2]);
+        auto a1 = _mm_setr_ps(a[0][1], a[1][1], a[2][1], a[3][1]);
+        auto a2 = _mm_setr_ps(a[0][2], a[1][2], a[2][2], a[3][2]);
+        auto s0 = _mm_setr_ps(state[0][0], state[1][0], state[2][0], state[3][0]);
+        auto s1 = _mm_setr_ps(state[0][1], state[1][1], state[2][1], state[3][1]);
+
+        auto previous = _mm_setzero_ps();
+        auto numSteps = numSamples + numLanes - 1;
+        auto peak = input.peak, sumOfSquares = input.sumOfSquares;
+
+        for (size_t t = 0; t < numSteps; ++t)
+        {
+            // lane 0 takes the next input sample, the others what the lane before them put out
+            auto sample = t < numSamples ? data[t] : 0.f;
+            auto x = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(previous), 4));
+            x = _mm_move_ss(x, _mm_set_ss(sample));
+
+            // the meter, by hand: std::abs and std::max are shared with the baseline build
+            auto magnitude = sample < 0.f ? -sample : sample;
+            peak = magnitude > peak ? magnitude : peak;
+            sumOfSquares += sample * sample;
+
+            auto y = _mm_fmadd_ps(b0, x, s0);
+            auto newS0 = _mm_fnmadd_ps(a1, y, _mm_fmadd_ps(b1, x, s1));
+            auto newS1 = _mm_fnmadd_ps(a2, y, _mm_mul_ps(b2, x));
+
+            if (t >= numLanes - 1 && t < numSamples)
+            {
+                s0 = newS0;
+                s1 = newS1;
+            }
+            else
+            {
+                // lane k is busy from step k to step numSamples - 1 + k
+                auto first = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+                auto step = _mm_set1_ps((float)t);
+                auto active = _mm_and_ps(_mm_cmple_ps(first, step),
+                                         _mm_cmpgt_ps(_mm_add_ps(first, _mm_set1_ps((float)numSamples)), step));
+
+                s0 = _mm_blendv_ps(s0, newS0, active);
+                s1 = _mm_blendv_ps(s1, newS1, active);
+            }
+
+            if (t >= numLanes - 1)
+                data[t - (numLanes - 1)] = _mm_cvtss_f32(_mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3))) * gain;
+
+            previous = y;
+        }
+
+        input.peak = peak;
+        input.sumOfSquares = sumOfSquares;
+
+        alignas(16) float lanes0[numLanes], lanes1[numLanes];
+        _mm_store_ps(lanes0, s0);
+        _mm_store_ps(lanes1, s1);
+
+        for (int k = 0; k < numLanes; ++k)
+        {
+            state[k][0] = lanes0[k];
+            state[k][1] = lanes1[k];
+        }
+    }
+
+    template <typename Ops>
+    void multiply(float* data, size_t numSamples, float gain) noexcept
+    {
+        auto gainVec = Ops::expand(gain);
+        size_t i = 0;
+
+        for (; i + Ops::width <= numSamples; i += Ops::width)
+            Ops::store(data + i, Ops::mul(Ops::load(data + i), gainVec));
+
+        for (; i < numSamples; ++i)
+            data[i] *= gain;
+    }
+
+    template <typename Ops>
+    void multiplyAndMeasure(float* data, size_t numSamples, float gain, SimdKernels::Levels& output) noexcept
+    {
+        auto gainVec = Ops::expand(gain);
+        auto peaks = Ops::expand(0.f), sums = Ops::expand(0.f);
+        size_t i = 0;
+
+        for (; i + Ops::width <= numSamples; i += Ops::width)
+        {
+            auto y = Ops::mul(Ops::load(data + i), gainVec);
+            Ops::store(data + i, y);
+
+            peaks = Ops::max(peaks, Ops::max(y, Ops::sub(Ops::expand(0.f), y)));
+            sums = Ops::fma(y, y, sums);
+        }
+
+        // across the lanes once per block
+        alignas(64) float peakLanes[Ops::width], sumLanes[Ops::width];
+        Ops::store(peakLanes, peaks);
+        Ops::store(sumLanes, sums);
+
+        auto peak = output.peak, sumOfSquares = 0.f;
+
+        for (size_t k = 0; k < Ops::width; ++k)
+        {
+            peak = peakLanes[k] > peak ? peakLanes[k] : peak;
+            sumOfSquares += sumLanes[k];
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            auto y = data[i] * gain;
+            data[i] = y;
+
+            auto magnitude = y < 0.f ? -y : y;
+            peak = magnitude > peak ? magnitude : peak;
+            sumOfSquares += y * y;
+        }
+
+        output.peak = peak;
+        output.sumOfSquares += sumOfSquares;
+    }
+
+    template <typename Ops>
+    void complexMultiplyAccumulate(float* acc, const float* x, const float* h, size_t numComplex) noexcept
+    {
+        constexpr size_t perVec = Ops::width / 2;
+        size_t i = 0;
+
+        for (; i + perVec <= numComplex; i += perVec)
+        {
+            auto xv = Ops::load(x + 2 * i), hv = Ops::load(h + 2 * i);
+
+            // (xr hr - xi hi, xr hi + xi hr)
+            auto product = Ops::fmaddsub(Ops::realParts(xv), hv, Ops::mul(Ops::imaginaryParts(xv), Ops::swapPairs(hv)));
+            Ops::store(acc + 2 * i, Ops::add(Ops::load(acc + 2 * i), product));
+        }
+
+        for (; i < numComplex; ++i)
+        {
+            auto xr = x[2 * i], xi = x[2 * i + 1];
+            auto hr = h[2 * i], hi = h[2 * i + 1];
+            acc[2 * i] += xr * hr - xi * hi;
+            acc[2 * i + 1] += xr * hi + xi * hr;
+        }
+    }
+
+    // A register of lanes per step instead of the four sections, the same FMAs as cascade
+    template <typename Ops, int numSections>
+    void laneCascadeSections(float* frames, size_t numFrames, size_t numLanes, const float (*b)[3], const float (*a)[3], float* state, float gain) noexcept
+    {
+        using Vec = typename Ops::Vec;
+
+        for (size_t lane = 0; lane < numLanes; lane += Ops::width)
+        {
+            Vec s[numSections][2];
+
+            for (int n = 0; n < numSections; ++n)
+                for (int k = 0; k < 2; ++k)
+                    s[n][k] = Ops::load(state + (size_t)(n * 2 + k) * numLanes + lane);
+
+            for (size_t i = 0; i < numFrames; ++i)
+            {
+                auto* frame = frames + i * numLanes + lane;
+                auto x = Ops::load(frame);
+
+                for (int n = 0; n < numSections; ++n)
+                {
+                    auto y = Ops::fma(Ops::expand(b[n][0]), x, s[n][0]);
+
+                    s[n][0] = Ops::fnma(Ops::expand(a[n][1]), y, Ops::fma(Ops::expand(b[n][1]), x, s[n][1]));
+                    s[n][1] = Ops::fnma(Ops::expand(a[n][2]), y, Ops::mul(Ops::expand(b[n][2]), x));
+
+                    x = y;
+                }
+
+                Ops::store(frame, Ops::mul(x, Ops::expand(gain)));
+            }
+
+            for (int n = 0; n < numSections; ++n)
+                for (int k = 0; k < 2; ++k)
+                    Ops::store(state + (size_t)(n * 2 + k) * numLanes + lane, s[n][k]);
+        }
+
+        // as juce::dsp::util::snapToZero does
+        for (size_t i = 0; i < (size_t)numSections * 2 * numLanes; ++i)
+            if (! (state[i] < -1.0e-8f || state[i] > 1.0e-8f))
+                state[i] = 0.f;
+    }
+
+    template <typename Ops>
+    void laneCascade(float* frames, size_t numFrames, size_t numLanes, const float (*b)[3], const float (*a)[3],
+                     float* state, int numSections, float gain) noexcept
+    {
+        switch (numSections)
+        {
+        case 1:     laneCascadeSections<Ops, 1>(frames, numFrames, numLanes, b, a, state, gain); break;
+        case 2:     laneCascadeSections<Ops, 2>(frames, numFrames, numLanes, b, a, state, gain); break;
+        case 3:     laneCascadeSections<Ops, 3>(frames, numFrames, numLanes, b, a, state, gain); break;
+        case 4:     laneCascadeSections<Ops, 4>(frames, numFrames, numLanes, b, a, state, gain); break;
+        default:    break;
+        }
+    }
+
+    template <typename Ops>
+    constexpr SimdKernels makeKernels(SimdKernels::Isa isa, const char* name) noexcept
+    {
+        return { isa, name,
+                 { &clip<Ops, &Curves<Ops>::atan>, &clip<Ops, &Curves<Ops>::tanh>, &clip<Ops, &Curves<Ops>::cubic>,
+                   &clip<Ops, &Curves<Ops>::hard>, &clip<Ops, &Curves<Ops>::asymmetric> },
+                 &cascade, &multiply<Ops>, &multiplyAndMeasure<Ops>, &complexMultiplyAccumulate<Ops>,
+                 Ops::width, &laneCascade<Ops> };
+    }
+}
+}
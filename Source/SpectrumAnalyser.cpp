@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.cpp
+    Created: 20 Oct 2026 2:31:44pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+
+SpectrumAnalyser::SpectrumAnalyser()
+{
+    setOpaque(true);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    for (auto& trace : traces)
+        trace->fifo->setActive(false);
+}
+
+void SpectrumAnalyser::addTrace(AnalyserFifo& fifo, juce::Colour colour, const juce::String& name)
+{
+    // whatever is left from a previous editor is stale
+    while (fifo.pull(scratch.data(), (int)scratch.size()) > 0) {}
+
+    auto trace = std::make_unique<Trace>();
+    trace->fifo = &fifo;
+    trace->colour = colour;
+    trace->name = name;
+    traces.push_back(std::move(trace));
+
+    fifo.setActive(true);
+}
+
+void SpectrumAnalyser::update()
+{
+    for (auto& trace : traces)
+    {
+        auto numRead = trace->fifo->pull(scratch.data(), (int)scratch.size());
+
+        // only the last fftSize samples matter
+        for (int i = juce::jmax(0, numRead - fftSize); i < numRead; ++i)
+        {
+            trace->history[(size_t)trace->historyPosition] = scratch[(size_t)i];
+            trace->historyPosition = (trace->historyPosition + 1) % fftSize;
+        }
+
+        if (numRead > 0)
+        {
+            analyse(*trace);
+            buildPath(*trace);
+        }
+        else if (! trace->levels.empty())
+        {
+            // let the trace fall when the audio stops
+            for (auto& level : trace->levels)
+                level = juce::jmax(minDecibels, level - 3.f);
+
+            buildPath(*trace);
+        }
+    }
+
+    repaint();
+}
+
+void SpectrumAnalyser::analyse(Trace& trace)
+{
+    // oldest sample first
+    std::copy(trace.history.begin() + trace.historyPosition, trace.history.end(), fftData.begin());
+    std::copy(trace.history.begin(), trace.history.begin() + trace.historyPosition, fftData.begin() + (fftSize - trace.historyPosition));
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.f);
+
+    window.multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    auto width = juce::jmax(1, getWidth());
+
+    if ((int)trace.levels.size() != width)
+        trace.levels.assign((size_t)width, minDecibels);
+
+    // a hann window halves the amplitude
+    auto normalisation = 4.f / (float)fftSize;
+
+    for (int x = 0; x < width; ++x)
+    {
+        auto frequency = minFrequency * std::pow(maxFrequency / minFrequency, (float)x / (float)width);
+        auto bin = juce::jlimit(1, fftSize / 2, juce::roundToInt(frequency * fftSize / sampleRate));
+        auto level = juce::Decibels::gainToDecibels(fftData[(size_t)bin] * normalisation, minDecibels);
+
+        // fast attack, slow release
+        auto& smoothed = trace.levels[(size_t)x];
+        smoothed = level > smoothed ? level : juce::jmax(level, smoothed - 1.5f);
+    }
+}
+
+void SpectrumAnalyser::buildPath(Trace& trace)
+{
+    trace.path.clear();
+
+    for (size_t x = 0; x < trace.levels.size(); ++x)
+    {
+        auto y = decibelsToY(trace.levels[x]);
+
+        if (x == 0)
+            trace.path.startNewSubPath(0.f, y);
+        else
+            trace.path.lineTo((float)x, y);
+    }
+}
+
+float SpectrumAnalyser::frequencyToX(float frequency) const noexcept
+{
+    return (float)getWidth() * std::log(frequency / minFrequency) / std::log(maxFrequency / minFrequency);
+}
+
+float SpectrumAnalyser::decibelsToY(float decibels) const noexcept
+{
+    return juce::jmap(decibels, minDecibels, maxDecibels, (float)getHeight(), 0.f);
+}
+
+void SpectrumAnalyser::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+    g.strokePath(grid, juce::PathStrokeType(1.f));
+
+    auto legend = getLocalBounds().reduced(6).removeFromTop(16);
+    g.setFont(12.f);
+
+    for (auto& trace : traces)
+    {
+        g.setColour(trace->colour);
+        g.strokePath(trace->path, juce::PathStrokeType(1.5f));
+        g.drawText(trace->name, legend.removeFromLeft(90), juce::Justification::centredLeft);
+    }
+}
+
+void SpectrumAnalyser::resized()
+{
+    grid.clear();
+
+    for (auto frequency : { 50.f, 100.f, 200.f, 500.f, 1000.f, 2000.f, 5000.f, 10000.f })
+    {
+        auto x = frequencyToX(frequency);
+        grid.startNewSubPath(x, 0.f);
+        grid.lineTo(x, (float)getHeight());
+    }
+
+    for (auto decibels = -84.f; decibels < maxDecibels; decibels += 12.f)
+    {
+        auto y = decibelsToY(decibels);
+        grid.startNewSubPath(0.f, y);
+        grid.lineTo((float)getWidth(), y);
+    }
+
+    for (auto& trace : traces)
+    {
+        trace->levels.clear();
+        trace->path.clear();
+    }
+}
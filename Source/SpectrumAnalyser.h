@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+    Created: 20 Oct 2026 2:31:44pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyserFifo.h"
+
+// Overlaid spectra of a few AnalyserFifos. All the work happens in update(), which the editor
+// calls from its timer, paint() only strokes the paths built there.
+class SpectrumAnalyser : public juce::Component
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+
+    static constexpr float minFrequency = 20.f, maxFrequency = 20000.f;
+    static constexpr float minDecibels = -96.f, maxDecibels = 6.f;
+
+    SpectrumAnalyser();
+    ~SpectrumAnalyser() override;
+
+    void addTrace(AnalyserFifo& fifo, juce::Colour colour, const juce::String& name);
+    void setSampleRate(double newSampleRate) noexcept   { sampleRate = newSampleRate; }
+
+    // Message thread, throttled by the caller
+    void update();
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    struct Trace
+    {
+        AnalyserFifo* fifo;
+        juce::Colour colour;
+        juce::String name;
+
+        std::vector<float> history = std::vector<float>(fftSize);
+        int historyPosition { 0 };
+        bool hasNewSamples { false };
+
+        std::vector<float> levels;
+        juce::Path path;
+    };
+
+    void analyse(Trace& trace);
+    void buildPath(Trace& trace);
+    float frequencyToX(float frequency) const noexcept;
+    float decibelsToY(float decibels) const noexcept;
+
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t)fftSize, juce::dsp::WindowingFunction<float>::hann };
+    std::vector<float> fftData = std::vector<float>(fftSize * 2);
+    std::vector<float> scratch = std::vector<float>(AnalyserFifo::capacity);
+
+    std::vector<std::unique_ptr<Trace>> traces;
+    juce::Path grid;
+    double sampleRate { 44100 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyser)
+};
@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+    Trace.cpp
+    Created: 24 Oct 2026 2:20:53pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "Trace.h"
+
+#if SOFTCLIPPINGPREAMP_TRACE
+
+namespace Trace
+{
+    namespace
+    {
+        struct Event
+        {
+            const char* name;
+            juce::int64 ticks;
+            int instance;
+            char phase;
+        };
+
+        // Written by its thread only, read by the Writer. Events that don't fit are dropped and counted.
+        struct ThreadBuffer
+        {
+            static constexpr juce::uint32 size = 1 << 14;
+
+            std::array<Event, size> events;
+            std::atomic<juce::uint32> writePosition { 0 }, readPosition { 0 }, numDropped { 0 };
+
+            // a spare is claimed by the first thread that records without having registered
+            std::atomic<bool> claimed { false };
+
+            int threadId { 0 };
+            juce::String threadName;
+            bool nameWritten { false };
+        };
+
+        // Never freed, the threads keep pointers into it past the last plugin instance.
+        // The spares get allocated off the audio thread, a thread that wasn't registered takes one
+        // with an exchange; with none left, its events are dropped and counted in numUnregistered.
+        struct Registry
+        {
+            static constexpr size_t numSpares = 4;
+
+            juce::CriticalSection lock;
+            juce::OwnedArray<ThreadBuffer> buffers;
+
+            std::array<std::atomic<ThreadBuffer*>, numSpares> spares {};
+            std::atomic<juce::uint32> numUnregistered { 0 };
+        };
+
+        Registry& getRegistry()
+        {
+            static auto* registry = new Registry();
+            return *registry;
+        }
+
+        thread_local ThreadBuffer* currentBuffer = nullptr;
+
+        juce::String getCurrentThreadName()
+        {
+            if (auto* thread = juce::Thread::getCurrentThread())
+                return thread->getThreadName();
+
+            if (auto* messageManager = juce::MessageManager::getInstanceWithoutCreating())
+                if (messageManager->isThisTheMessageThread())
+                    return "Message thread";
+
+            return "Unnamed thread";
+        }
+
+        ThreadBuffer* addBuffer(const juce::String& threadName, bool claimed)
+        {
+            auto newBuffer = std::make_unique<ThreadBuffer>();
+            newBuffer->threadName = threadName;
+            newBuffer->claimed.store(claimed);
+
+            auto& registry = getRegistry();
+            const juce::ScopedLock sl(registry.lock);
+
+            newBuffer->threadId = registry.buffers.size() + 1;
+            return registry.buffers.add(newBuffer.release());
+        }
+
+        // From the Writer, on the message and the background threads
+        void topUpSpares()
+        {
+            auto& registry = getRegistry();
+            const juce::ScopedLock sl(registry.lock);
+
+            for (auto& spare : registry.spares)
+                if (spare.load() == nullptr)
+                    spare.store(addBuffer("Host thread", false));   // most likely the host's audio thread
+        }
+
+        // Neither allocates nor locks
+        ThreadBuffer* getThreadBuffer() noexcept
+        {
+            if (currentBuffer == nullptr)
+            {
+                for (auto& spare : getRegistry().spares)
+                {
+                    if (auto* buffer = spare.exchange(nullptr))
+                    {
+                        buffer->claimed.store(true, std::memory_order_release);
+                        currentBuffer = buffer;
+                        break;
+                    }
+                }
+            }
+
+            return currentBuffer;
+        }
+
+        void record(const char* name, int instance, char phase) noexcept
+        {
+            auto* buffer = getThreadBuffer();
+
+            if (buffer == nullptr)
+            {
+                getRegistry().numUnregistered.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto position = buffer->writePosition.load(std::memory_order_relaxed);
+
+            if (position - buffer->readPosition.load(std::memory_order_acquire) >= ThreadBuffer::size)
+            {
+                buffer->numDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            buffer->events[position % ThreadBuffer::size] = { name, juce::Time::getHighResolutionTicks(), instance, phase };
+            buffer->writePosition.store(position + 1, std::memory_order_release);
+        }
+
+        juce::File getTraceFile()
+        {
+            auto path = juce::SystemStats::getEnvironmentVariable("SOFTCLIPPINGPREAMP_TRACE_FILE", {});
+
+            if (path.isNotEmpty() && juce::File::isAbsolutePath(path))
+                return juce::File(path);
+
+            return juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("SoftClippingPreamp-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+        }
+    }
+
+    void registerThread()
+    {
+        if (currentBuffer == nullptr)
+            currentBuffer = addBuffer(getCurrentThreadName(), true);
+    }
+
+    void begin(const char* name, int instance) noexcept    { record(name, instance, 'B'); }
+    void end(const char* name, int instance) noexcept      { record(name, instance, 'E'); }
+
+    Writer::Writer()
+    {
+        auto file = getTraceFile();
+        file.deleteFile();
+        stream = file.createOutputStream();
+
+        // The closing bracket is optional in the trace event format, so a file cut short still loads
+        if (stream != nullptr)
+            *stream << "[\n";
+
+        registerThread();
+        topUpSpares();
+
+        backgroundThread->addTimeSliceClient(this);
+    }
+
+    Writer::~Writer()
+    {
+        backgroundThread->removeTimeSliceClient(this);
+        flush();
+    }
+
+    int Writer::useTimeSlice()
+    {
+        registerThread();
+        topUpSpares();
+        flush();
+        return 100;
+    }
+
+    void Writer::flush()
+    {
+        const juce::ScopedLock fl(flushLock);
+
+        if (stream == nullptr)
+            return;
+
+        auto microsecondsPerTick = 1.0e6 / (double)juce::Time::getHighResolutionTicksPerSecond();
+
+        // Buffers only ever get added, so the lock isn't needed past the copy. Only registering
+        // threads and the spares' top up take it.
+        juce::Array<ThreadBuffer*> buffers;
+
+        {
+            auto& registry = getRegistry();
+            const juce::ScopedLock sl(registry.lock);
+            buffers.addArray(registry.buffers.begin(), registry.buffers.size());
+        }
+
+        for (auto* buffer : buffers)
+        {
+            if (! buffer->claimed.load(std::memory_order_acquire))
+                continue;
+
+            if (! buffer->nameWritten)
+            {
+                *stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                        << ",\"args\":{\"name\":" << buffer->threadName.quoted() << "}},\n";
+                buffer->nameWritten = true;
+            }
+
+            auto read = buffer->readPosition.load(std::memory_order_relaxed);
+            auto write = buffer->writePosition.load(std::memory_order_acquire);
+
+            for (; read != write; ++read)
+            {
+                auto& event = buffer->events[read % ThreadBuffer::size];
+
+                *stream << "{\"name\":\"" << event.name << "\",\"ph\":\"" << juce::String::charToString(event.phase)
+                        << "\",\"ts\":" << juce::String((double)event.ticks * microsecondsPerTick, 1)
+                        << ",\"pid\":1,\"tid\":" << buffer->threadId;
+
+                if (event.instance > 0)
+                    *stream << ",\"args\":{\"instance\":" << event.instance << "}";
+
+                *stream << "},\n";
+            }
+
+            buffer->readPosition.store(read, std::memory_order_release);
+
+            if (auto dropped = buffer->numDropped.exchange(0))
+                *stream << "{\"name\":\"" << (int)dropped << " events dropped\",\"ph\":\"i\",\"s\":\"t\",\"ts\":"
+                        << juce::String((double)juce::Time::getHighResolutionTicks() * microsecondsPerTick, 1)
+                        << ",\"pid\":1,\"tid\":" << buffer->threadId << "},\n";
+        }
+
+        if (auto unregistered = getRegistry().numUnregistered.exchange(0))
+            *stream << "{\"name\":\"" << (int)unregistered << " events from unregistered threads dropped\",\"ph\":\"i\",\"s\":\"g\",\"ts\":"
+                    << juce::String((double)juce::Time::getHighResolutionTicks() * microsecondsPerTick, 1) << ",\"pid\":1,\"tid\":0},\n";
+
+        stream->flush();
+    }
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    Trace.h
+    Created: 24 Oct 2026 2:20:53pm
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// A timeline of what the audio, worker, message and background threads were doing, for chrome://tracing
+// or ui.perfetto.dev. Only built with SOFTCLIPPINGPREAMP_TRACE=1 in the preprocessor definitions,
+// otherwise the macros below compile to nothing.
+//
+// TRACE_SCOPE("name") records a begin and an end event around the enclosing scope, name must be a
+// string literal. Each thread writes into its own lock-free ring, recording never allocates or locks.
+// Threads we start call TRACE_THREAD() first, which allocates theirs; any other thread, such as the
+// host's audio thread, takes one of a few rings allocated beforehand, and once those have run out its
+// events are dropped. Trace::Writer drains the rings from the shared background thread into a JSON file,
+// the one in SOFTCLIPPINGPREAMP_TRACE_FILE or SoftClippingPreamp-<time>.json in the temp directory.
+#ifndef SOFTCLIPPINGPREAMP_TRACE
+ #define SOFTCLIPPINGPREAMP_TRACE 0
+#endif
+
+#if SOFTCLIPPINGPREAMP_TRACE
+
+#include "BackgroundThread.h"
+
+namespace Trace
+{
+    // Not from the audio thread, it allocates the calling thread's ring if it has none
+    void registerThread();
+
+    void begin(const char* name, int instance) noexcept;
+    void end(const char* name, int instance) noexcept;
+
+    struct Scope
+    {
+        Scope(const char* eventName, int eventInstance) noexcept : name(eventName), instance(eventInstance)   { begin(name, instance); }
+        ~Scope()                                                                                                { end(name, instance); }
+
+        const char* name;
+        int instance;
+    };
+
+    // Writes the events to the file while at least one exists, use it through a juce::SharedResourcePointer
+    class Writer : private juce::TimeSliceClient
+    {
+    public:
+        Writer();
+        ~Writer() override;
+
+    private:
+        int useTimeSlice() override;
+        void flush();
+
+        std::unique_ptr<juce::FileOutputStream> stream;
+        juce::CriticalSection flushLock;
+
+        juce::SharedResourcePointer<BackgroundThread> backgroundThread;
+    };
+}
+
+ #define TRACE_THREAD()                            Trace::registerThread()
+ #define TRACE_SCOPE(name)                         const Trace::Scope JUCE_JOIN_MACRO(traceScope, __LINE__) (name, 0)
+ #define TRACE_INSTANCE_SCOPE(name, instance)      const Trace::Scope JUCE_JOIN_MACRO(traceScope, __LINE__) (name, instance)
+
+#else
+
+ #define TRACE_THREAD()
+ #define TRACE_SCOPE(name)
+ #define TRACE_INSTANCE_SCOPE(name, instance)
+
+#endif
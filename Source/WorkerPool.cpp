@@ -0,0 +1,294 @@
+/*
+  ==============================================================================
+
+    WorkerPool.cpp
+    Created: 20 Oct 2026 9:41:17am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#include "WorkerPool.h"
+#include "Trace.h"
+
+#if JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <errno.h>
+ #include <semaphore.h>
+ #include <time.h>
+#endif
+
+namespace
+{
+    inline void spinPause() noexcept
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #else
+        std::this_thread::yield();
+       #endif
+    }
+}
+
+//==============================================================================
+// The platform's counting semaphore. Posting it is an atomic increment, plus a system call when a
+// thread waits, where juce::WaitableEvent::signal() locks a mutex.
+class WorkerPool::Semaphore
+{
+public:
+   #if JUCE_WINDOWS
+    Semaphore()     : handle(CreateSemaphore(nullptr, 0, LONG_MAX, nullptr)) {}
+    ~Semaphore()    { CloseHandle(handle); }
+
+    void post() noexcept                        { ReleaseSemaphore(handle, 1, nullptr); }
+    void wait(int milliseconds) noexcept        { WaitForSingleObject(handle, (DWORD)milliseconds); }
+
+   private:
+    HANDLE handle;
+   #elif JUCE_MAC || JUCE_IOS
+    Semaphore()     : semaphore(dispatch_semaphore_create(0)) {}
+    ~Semaphore()    { dispatch_release(semaphore); }
+
+    void post() noexcept                        { dispatch_semaphore_signal(semaphore); }
+    void wait(int milliseconds) noexcept
+    {
+        dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)milliseconds * 1000000));
+    }
+
+   private:
+    dispatch_semaphore_t semaphore;
+   #else
+    Semaphore()     { sem_init(&semaphore, 0, 0); }
+    ~Semaphore()    { sem_destroy(&semaphore); }
+
+    void post() noexcept                        { sem_post(&semaphore); }
+    void wait(int milliseconds) noexcept
+    {
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+
+        auto nanoseconds = deadline.tv_nsec + (long)milliseconds * 1000000;
+        deadline.tv_sec += nanoseconds / 1000000000;
+        deadline.tv_nsec = nanoseconds % 1000000000;
+
+        while (sem_timedwait(&semaphore, &deadline) != 0 && errno == EINTR) {}
+    }
+
+   private:
+    sem_t semaphore;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (Semaphore)
+};
+
+//==============================================================================
+bool WorkerPool::Job::tryRun() noexcept
+{
+    auto expected = (int)queued;
+
+    if (! state.compare_exchange_strong(expected, (int)running))
+        return false;
+
+    run();
+    state.store(done);
+    return true;
+}
+
+void WorkerPool::Job::finish() noexcept
+{
+    if (tryRun())
+        return;
+
+    while (state.load() == running)
+        spinPause();
+}
+
+void WorkerPool::Job::runNow() noexcept
+{
+    jassert(isIdle());
+
+    state.store(running);
+    run();
+    state.store(done);
+}
+
+void WorkerPool::Job::waitUntilReleased() const noexcept
+{
+    while (queueReferences.load() > 0 || state.load() == running)
+        juce::Thread::sleep(1);
+}
+
+//==============================================================================
+class WorkerPool::Worker : public juce::Thread
+{
+public:
+    Worker(WorkerPool& p, int index) : juce::Thread("SoftClippingPreamp worker " + juce::String(index)), pool(p) {}
+
+    void run() override
+    {
+        // how long to keep polling before parking, at roughly 50 ns per pause
+        constexpr int spinCount = 2000;
+
+        TRACE_THREAD();
+
+        while (! threadShouldExit())
+        {
+            if (auto* job = pool.pop())
+            {
+                job->tryRun();
+                job->queueReferences.fetch_sub(1);
+                continue;
+            }
+
+            bool found = false;
+
+            for (int i = 0; i < spinCount && ! found; ++i)
+            {
+                spinPause();
+                found = pool.dequeuePosition.load() != pool.enqueuePosition.load();
+            }
+
+            if (found)
+                continue;
+
+            // Announce the park before the last look at the queue, so a submit either sees
+            // a parked worker to wake or we see its job
+            pool.numParked.fetch_add(1);
+
+            if (pool.dequeuePosition.load() == pool.enqueuePosition.load())
+                pool.wakeSemaphore->wait(100);
+
+            pool.numParked.fetch_sub(1);
+        }
+    }
+
+private:
+    WorkerPool& pool;
+};
+
+//==============================================================================
+WorkerPool::WorkerPool() : cells(new Cell[queueSize]), wakeSemaphore(std::make_unique<Semaphore>())
+{
+    for (size_t i = 0; i < queueSize; ++i)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+
+    auto numWorkers = juce::jlimit(1, 8, juce::SystemStats::getNumCpus() - 1);
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.add(new Worker(*this, i))->startThread(8);
+}
+
+WorkerPool::~WorkerPool()
+{
+    for (auto* w : workers)
+        w->signalThreadShouldExit();
+
+    for (int i = 0; i < workers.size(); ++i)
+        wakeSemaphore->post();
+
+    for (auto* w : workers)
+        w->stopThread(2000);
+}
+
+bool WorkerPool::submit(Job& job) noexcept
+{
+    auto expected = (int)Job::done;
+
+    if (! job.state.compare_exchange_strong(expected, (int)Job::queued))
+    {
+        expected = (int)Job::idle;
+
+        if (! job.state.compare_exchange_strong(expected, (int)Job::queued))
+        {
+            jassertfalse; // still queued or running, finish() it first
+            return false;
+        }
+    }
+
+    job.queueReferences.fetch_add(1);
+
+    if (! push(&job))
+    {
+        job.queueReferences.fetch_sub(1);
+        job.state.store(Job::idle);
+        return false;
+    }
+
+    wakeOne();
+    return true;
+}
+
+void WorkerPool::wakeOne() noexcept
+{
+    // A post that no parked worker takes only costs some worker one extra turn round its loop
+    if (numParked.load() > 0)
+        wakeSemaphore->post();
+}
+
+bool WorkerPool::push(Job* job) noexcept
+{
+    auto position = enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    for (;;)
+    {
+        cell = &cells[position & (queueSize - 1)];
+        auto sequence = cell->sequence.load(std::memory_order_acquire);
+        auto difference = (intptr_t)sequence - (intptr_t)position;
+
+        if (difference == 0)
+        {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->job = job;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+WorkerPool::Job* WorkerPool::pop() noexcept
+{
+    auto position = dequeuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    for (;;)
+    {
+        cell = &cells[position & (queueSize - 1)];
+        auto sequence = cell->sequence.load(std::memory_order_acquire);
+        auto difference = (intptr_t)sequence - (intptr_t)(position + 1);
+
+        if (difference == 0)
+        {
+            if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            return nullptr;
+        }
+        else
+        {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto* job = cell->job;
+    cell->sequence.store(position + queueSize, std::memory_order_release);
+    return job;
+}
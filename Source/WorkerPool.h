@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    WorkerPool.h
+    Created: 20 Oct 2026 9:41:17am
+    Author:  ihorv
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Worker threads shared by every plugin instance in the process, for DSP work the audio thread
+// hands off and collects later in the same or a following callback. Use it through
+// juce::SharedResourcePointer<WorkerPool>.
+//
+// Submitting is a push onto a bounded lock-free queue. Idle workers spin for a short while before
+// parking on a semaphore, and a parked worker is only woken when the queue was seen empty. Waking
+// posts the semaphore, which takes no lock.
+class WorkerPool
+{
+public:
+    // A unit of work that can be submitted again once it has finished. Whoever gets to it first runs
+    // it: a worker, or the submitting thread through finish() when the result is needed right away.
+    class Job
+    {
+    public:
+        virtual ~Job() = default;
+
+        bool isIdle() const noexcept        { auto s = state.load(); return s == idle || s == done; }
+
+        // Makes sure the job has run, running it on the calling thread if no worker has started it
+        void finish() noexcept;
+
+        // Runs the job on the calling thread instead of submitting it
+        void runNow() noexcept;
+
+        // Blocks until no queue entry refers to this job any more, call before destroying it
+        void waitUntilReleased() const noexcept;
+
+    protected:
+        virtual void run() noexcept = 0;
+
+    private:
+        friend class WorkerPool;
+
+        enum State { idle, queued, running, done };
+
+        bool tryRun() noexcept;
+
+        std::atomic<int> state { idle };
+        std::atomic<int> queueReferences { 0 };
+    };
+
+    WorkerPool();
+    ~WorkerPool();
+
+    // Lock free, safe on the audio thread. Returns false when the queue is full, in which case the
+    // caller should runNow().
+    bool submit(Job& job) noexcept;
+
+    int getNumWorkers() const noexcept      { return workers.size(); }
+
+private:
+    class Worker;
+
+    Job* pop() noexcept;
+    bool push(Job* job) noexcept;
+    void wakeOne() noexcept;
+
+    class Semaphore;
+
+    // Bounded multi producer / multi consumer queue, after Dmitry Vyukov's design
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        Job* job;
+    };
+
+    static constexpr size_t queueSize = 1024;
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePosition { 0 };
+    alignas(64) std::atomic<size_t> dequeuePosition { 0 };
+
+    std::atomic<int> numParked { 0 };
+    std::unique_ptr<Semaphore> wakeSemaphore;
+
+    juce::OwnedArray<Worker> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerPool)
+};